@@ -0,0 +1,3832 @@
+/*******************************************************************************
+* File Name: cy_hpi_master.c
+* \version 1.1.0
+*
+* Implements the HPI master middleware.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_hpi_master.h"
+
+/* Valid flags of the registers in the port register cache. */
+#define CY_HPI_MASTER_CACHE_PD_STATUS                 (0x01U)
+#define CY_HPI_MASTER_CACHE_TYPE_C_STATUS             (0x02U)
+#define CY_HPI_MASTER_CACHE_CURRENT_PDO               (0x04U)
+#define CY_HPI_MASTER_CACHE_CURRENT_RDO               (0x08U)
+#define CY_HPI_MASTER_CACHE_ALL                       (CY_HPI_MASTER_CACHE_PD_STATUS | \
+                                                       CY_HPI_MASTER_CACHE_TYPE_C_STATUS | \
+                                                       CY_HPI_MASTER_CACHE_CURRENT_PDO | \
+                                                       CY_HPI_MASTER_CACHE_CURRENT_RDO)
+
+/* HPI register address of the flash data memory. */
+#define CY_HPI_MASTER_FLASH_MEM_ADDR                  (0x0200U)
+
+/* Offset of the PD response read region in a port register space. */
+#define CY_HPI_MASTER_PD_RESP_READ_OFFSET             (0x0400U)
+
+/* Offset of the PD response write region in a port register space. */
+#define CY_HPI_MASTER_PD_RESP_WRITE_OFFSET            (0x0800U)
+
+/* Size of the response header: code, reserved byte, and 16-bit length. */
+#define CY_HPI_MASTER_RESP_HDR_SIZE                   (4U)
+
+/* Size of the event record header in the event queue: event code, port,
+ * slave index, and 16-bit data length. */
+#define CY_HPI_MASTER_EVT_HDR_SIZE                    (5U)
+
+/* Event record code which marks the unused end of the event queue buffer.
+ * Queued events are asynchronous events, which have bit 7 of the code set. */
+#define CY_HPI_MASTER_EVT_WRAP                        (0x00U)
+
+/* Flag set in the port byte of event queue records whose data is held in an
+ * event pool block. The record data is then the pointer to the event data. */
+#define CY_HPI_MASTER_EVT_POOL_FLAG                   (0x40U)
+
+/* Flag set in the port byte of event queue records which end with the time
+ * stamp of the slave interrupt, when the trace is enabled. */
+#define CY_HPI_MASTER_EVT_TRACE_FLAG                  (0x20U)
+
+/* Size of the interrupt time stamp at the end of traced event records. */
+#define CY_HPI_MASTER_EVT_STAMP_SIZE                  (4U)
+
+/* Maximum number of SCL pulses generated by the bus recovery sequence. A
+ * slave device holding SDA low releases it within one byte and the ACK bit. */
+#define CY_HPI_MASTER_RECOVERY_CLOCKS                 (9U)
+
+/* SCL half period of the bus recovery sequence in microseconds (100 kHz). */
+#define CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US         (5U)
+
+/* Time in microseconds without a completed asynchronous transfer after which
+ * a wait for the queued transfers gives up. Longer than a 256-byte transfer
+ * at 100 kHz. */
+#define CY_HPI_MASTER_XFER_TIMEOUT_US                 (50000U)
+
+/* Poll period in microseconds of a wait for queued asynchronous transfers. */
+#define CY_HPI_MASTER_XFER_POLL_US                    (100U)
+
+/* Port number reported with device-level events and errors. */
+#define CY_HPI_MASTER_DEV_PORT                        (0xFFU)
+
+/* Size of the port status registers, PD_STATUS to CURRENT_RDO. */
+#define CY_HPI_MASTER_PORT_STATUS_SIZE                (16U)
+
+/* Unit of the BUS_VOLTAGE register in mV. */
+#define CY_HPI_MASTER_BUS_VOLTAGE_UNIT                (100U)
+
+/* Unit of the BUS_CURRENT register in mA. */
+#define CY_HPI_MASTER_BUS_CURRENT_UNIT                (50U)
+
+/* Lookup table for the count of trailing zeros, indexed by the De Bruijn
+ * product of the isolated lowest set bit. Cortex-M0 has no CLZ/RBIT. */
+static const uint8_t gl_HpiMasterCtzTable[32] =
+{
+    0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+    31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+};
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_Ctz
+****************************************************************************//**
+*
+* Returns the index of the lowest set bit of a non-zero value.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_Ctz(uint32_t value)
+{
+    return gl_HpiMasterCtzTable[((value & (0U - value)) * 0x077CB531U) >> 27];
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetU32
+****************************************************************************//**
+*
+* Returns the little-endian 32-bit register value at the given address.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_GetU32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SetPending
+****************************************************************************//**
+*
+* Sets the interrupt pending bit of a slave device.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_SetPending(cy_hpi_master_context_t *context, uint8_t slaveIdx)
+{
+    uint32_t word = (uint32_t)slaveIdx >> 5;
+    uint32_t intrState;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if ((context->ptrTrace != NULL) && ((context->ptrIntrMask[word] & (1UL << (slaveIdx & 0x1FU))) == 0U))
+    {
+        context->ptrSlaves[slaveIdx].intrTimestamp = context->ptrAppCbk->get_timestamp();
+    }
+    context->ptrIntrMask[word] |= (1UL << (slaveIdx & 0x1FU));
+    context->intrSummary |= (1UL << word);
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ClearPending
+****************************************************************************//**
+*
+* Clears the interrupt pending bit of a slave device.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ClearPending(cy_hpi_master_context_t *context, uint8_t slaveIdx)
+{
+    uint32_t word = (uint32_t)slaveIdx >> 5;
+    uint32_t intrState;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    context->ptrIntrMask[word] &= ~(1UL << (slaveIdx & 0x1FU));
+    if (context->ptrIntrMask[word] == 0U)
+    {
+        context->intrSummary &= ~(1UL << word);
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FindNextPending
+****************************************************************************//**
+*
+* Returns the index of the first slave device at or after startIdx which has
+* an interrupt pending, or CY_HPI_MASTER_UNKNOWN_SLAVE_IDX if there is none.
+* The search uses the summary word and does not depend on the number of slave
+* devices.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_FindNextPending(cy_hpi_master_context_t *context, uint32_t startIdx)
+{
+    uint32_t word = startIdx >> 5;
+    uint32_t bits;
+    uint32_t summary;
+    uint32_t slaveIdx;
+
+    if (startIdx >= context->slaveCount)
+    {
+        return CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+    }
+
+    bits = context->ptrIntrMask[word] & (0xFFFFFFFFUL << (startIdx & 0x1FU));
+    if (bits == 0U)
+    {
+        summary = (word < 31U) ? (context->intrSummary & (0xFFFFFFFFUL << (word + 1U))) : 0U;
+        if (summary == 0U)
+        {
+            return CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+        }
+
+        word = Cy_HPI_Master_Ctz(summary);
+        bits = context->ptrIntrMask[word];
+    }
+
+    slaveIdx = (word << 5) + Cy_HPI_Master_Ctz(bits);
+
+    return (slaveIdx < context->slaveCount) ? (uint8_t)slaveIdx : CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SetPriority
+****************************************************************************//**
+*
+* Adds a slave device to or removes it from the priority class.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_SetPriority(cy_hpi_master_context_t *context, uint8_t slaveIdx, bool prio)
+{
+    uint32_t word = (uint32_t)slaveIdx >> 5;
+    uint32_t bit  = 1UL << (slaveIdx & 0x1FU);
+
+    if (prio)
+    {
+        context->ptrPrioMask[word] |= bit;
+    }
+    else
+    {
+        context->ptrPrioMask[word] &= ~bit;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_IsFaultEvent
+****************************************************************************//**
+*
+* Checks whether an event code reports an overcurrent, overvoltage, or
+* overtemperature condition.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_IsFaultEvent(uint8_t eventCode)
+{
+    return ((eventCode == (uint8_t)CY_HPI_MASTER_EVENT_OC_DETECT) ||
+            (eventCode == (uint8_t)CY_HPI_MASTER_EVENT_OV_DETECT) ||
+            (eventCode == (uint8_t)CY_HPI_MASTER_EVENT_OT_DETECT));
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ReportError
+****************************************************************************//**
+*
+* Reports an error condition related to a slave device to the application.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ReportError(cy_hpi_master_context_t *context,
+                                      cy_hpi_master_slave_dev_t *slaveDev,
+                                      cy_hpi_master_status_t status)
+{
+    cy_hpi_master_event_t event;
+
+    if (context->ptrAppCbk->error_handler != NULL)
+    {
+        event.slaveDev  = slaveDev;
+        event.port      = CY_HPI_MASTER_DEV_PORT;
+        event.eventCode = (uint8_t)status;
+        event.eventData = NULL;
+        event.dataLen   = 0U;
+
+        (void)context->ptrAppCbk->error_handler(context, &event);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TraceTime
+****************************************************************************//**
+*
+* Returns the current time stamp if the trace is enabled, or 0.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_TraceTime(cy_hpi_master_context_t *context)
+{
+    return (context->ptrTrace != NULL) ? context->ptrAppCbk->get_timestamp() : 0U;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TraceRecord
+****************************************************************************//**
+*
+* Adds a transaction or an event delivery which started at the given time
+* stamp to the statistics of its slave device and class, and to the trace
+* record ring.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TraceRecord(cy_hpi_master_context_t *context,
+                                      uint8_t slaveIdx,
+                                      uint8_t slaveAddr,
+                                      uint8_t traceClass,
+                                      uint16_t regAddr,
+                                      uint16_t length,
+                                      uint8_t flags,
+                                      uint32_t timestamp)
+{
+    cy_hpi_master_trace_t *trace = context->ptrTrace;
+    cy_hpi_master_trace_stats_t *stats;
+    cy_hpi_master_trace_rec_t *rec;
+    uint32_t latency = context->ptrAppCbk->get_timestamp() - timestamp;
+    uint32_t bucket = 0U;
+    uint32_t intrState;
+
+    while ((bucket < (CY_HPI_MASTER_TRACE_BUCKETS - 1U)) && ((latency >> bucket) != 0U))
+    {
+        bucket++;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+
+    if (slaveIdx < context->slaveCount)
+    {
+        stats = &trace->ptrStats[((uint32_t)slaveIdx * CY_HPI_MASTER_TRACE_CLASS_COUNT) + traceClass];
+        stats->count++;
+        if ((flags & CY_HPI_MASTER_TRACE_FLAG_ERROR) != 0U)
+        {
+            stats->errors++;
+        }
+        else
+        {
+            stats->bytes += length;
+        }
+        if (latency > stats->maxLatency)
+        {
+            stats->maxLatency = latency;
+        }
+        stats->hist[bucket]++;
+    }
+
+    if (trace->ptrRing != NULL)
+    {
+        rec = &trace->ptrRing[trace->ringIdx];
+        rec->timestamp = timestamp;
+        rec->latency   = latency;
+        rec->regAddr   = regAddr;
+        rec->length    = length;
+        rec->slaveAddr = slaveAddr;
+        rec->flags     = flags;
+
+        trace->ringIdx = (uint16_t)(((uint32_t)trace->ringIdx + 1U) % trace->ringSize);
+        trace->ringCount++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TraceXfer
+****************************************************************************//**
+*
+* Traces a register transaction, classified by its register address.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TraceXfer(cy_hpi_master_context_t *context,
+                                    uint8_t slaveIdx,
+                                    uint8_t slaveAddr,
+                                    uint16_t regAddress,
+                                    uint16_t length,
+                                    uint8_t flags,
+                                    uint32_t timestamp)
+{
+    uint8_t traceClass;
+
+    if ((regAddress >> 12) == 0U)
+    {
+        traceClass = (regAddress >= CY_HPI_MASTER_FLASH_MEM_ADDR) ? CY_HPI_MASTER_TRACE_CLASS_FLASH :
+                                                                   CY_HPI_MASTER_TRACE_CLASS_DEV;
+    }
+    else
+    {
+        traceClass = ((regAddress & 0x0FFFU) >= CY_HPI_MASTER_PD_RESP_READ_OFFSET) ?
+                     CY_HPI_MASTER_TRACE_CLASS_PD_RESP : CY_HPI_MASTER_TRACE_CLASS_PORT;
+    }
+
+    Cy_HPI_Master_TraceRecord(context, slaveIdx, slaveAddr, traceClass, regAddress, length, flags, timestamp);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TraceEvent
+****************************************************************************//**
+*
+* Traces the delivery of an event to the event handler, from the slave
+* interrupt at the given time stamp.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TraceEvent(cy_hpi_master_context_t *context,
+                                     uint8_t slaveIdx,
+                                     uint8_t port,
+                                     uint8_t eventCode,
+                                     uint16_t dataLen,
+                                     uint32_t timestamp)
+{
+    Cy_HPI_Master_TraceRecord(context, slaveIdx, context->ptrSlaves[slaveIdx].slaveAddr,
+                              CY_HPI_MASTER_TRACE_CLASS_EVENT, (uint16_t)(((uint16_t)port << 8) | eventCode),
+                              dataLen, CY_HPI_MASTER_TRACE_FLAG_EVENT, timestamp);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PoolCount
+****************************************************************************//**
+*
+* Returns the number of event pools.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_PoolCount(const cy_hpi_master_context_t *context)
+{
+    if (context->ptrEvtPool == NULL)
+    {
+        return 0U;
+    }
+
+    return (context->evtPoolCount == 0U) ? 1U : context->evtPoolCount;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PoolAlloc
+****************************************************************************//**
+*
+* Allocates a block for dataLen bytes of event data from the pool with the
+* smallest blocks which has a free block large enough. The pool is returned
+* in ptrPool. Returns NULL if the event pool is not used or no block is free.
+*
+*******************************************************************************/
+static uint8_t *Cy_HPI_Master_PoolAlloc(cy_hpi_master_context_t *context,
+                                        uint16_t dataLen,
+                                        cy_hpi_master_evt_pool_t **ptrPool)
+{
+    cy_hpi_master_evt_pool_t *pool;
+    cy_hpi_master_evt_pool_t *failPool = NULL;
+    uint8_t poolCount = Cy_HPI_Master_PoolCount(context);
+    uint8_t poolIdx;
+    uint32_t intrState;
+    uint32_t freeMask;
+    uint8_t blockIdx;
+
+    for (poolIdx = 0U; poolIdx < poolCount; poolIdx++)
+    {
+        pool = &context->ptrEvtPool[poolIdx];
+        if (((uint32_t)dataLen + CY_HPI_MASTER_EVT_POOL_HDR_SIZE) > pool->blockSize)
+        {
+            continue;
+        }
+
+        if (failPool == NULL)
+        {
+            failPool = pool;
+        }
+
+        intrState = Cy_SysLib_EnterCriticalSection();
+        freeMask  = pool->freeMask;
+        if (freeMask != 0U)
+        {
+            pool->freeMask = freeMask & (freeMask - 1U);
+            Cy_SysLib_ExitCriticalSection(intrState);
+
+            blockIdx = Cy_HPI_Master_Ctz(freeMask);
+            *ptrPool = pool;
+
+            return &pool->startAddress[(uint32_t)blockIdx * pool->blockSize];
+        }
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+
+    if (poolCount != 0U)
+    {
+        /* Count the failure in the pool of the size class of the event, or
+         * in the pool with the largest blocks if the data fits in none. */
+        if (failPool == NULL)
+        {
+            failPool = &context->ptrEvtPool[poolCount - 1U];
+        }
+        failPool->allocFailCount++;
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_QueueReleaseRecord
+****************************************************************************//**
+*
+* Releases the event pool block referenced by an event queue record which is
+* dropped without being passed to the event handler.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_QueueReleaseRecord(cy_hpi_master_context_t *context, const uint8_t *record)
+{
+    uint8_t *eventData;
+
+    if ((record[1] & CY_HPI_MASTER_EVT_POOL_FLAG) != 0U)
+    {
+        (void)memcpy((void *)&eventData, &record[CY_HPI_MASTER_EVT_HDR_SIZE], sizeof(eventData));
+        Cy_HPI_Master_EventRelease(context, eventData);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_QueueFindSpace
+****************************************************************************//**
+*
+* Returns the event queue index where a record of the given size can be
+* stored, or the buffer size if there is not enough free space. Records are
+* never split; a record which does not fit at the end of the buffer is stored
+* at the start. One byte is always left free so that a full queue can be told
+* apart from an empty one.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_QueueFindSpace(const cy_hpi_master_event_queue_t *queue,
+                                             uint32_t headIdx,
+                                             uint32_t tailIdx,
+                                             uint32_t recordSize)
+{
+    uint32_t bufferSize = queue->bufferSize;
+
+    if (tailIdx >= headIdx)
+    {
+        if ((recordSize < (bufferSize - tailIdx)) ||
+            ((recordSize == (bufferSize - tailIdx)) && (headIdx != 0U)))
+        {
+            return tailIdx;
+        }
+        if (recordSize < headIdx)
+        {
+            return 0U;
+        }
+    }
+    else if (recordSize < (headIdx - tailIdx))
+    {
+        return tailIdx;
+    }
+    else
+    {
+        /* Not enough free space. */
+    }
+
+    return bufferSize;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_QueueNextRecord
+****************************************************************************//**
+*
+* Returns the index of the record which follows the record at the given
+* index. The caller skips the wrap marker.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_QueueNextRecord(const cy_hpi_master_event_queue_t *queue, uint32_t idx)
+{
+    const uint8_t *record = &queue->startAddress[idx];
+
+    idx += CY_HPI_MASTER_EVT_HDR_SIZE + ((uint32_t)record[3] | ((uint32_t)record[4] << 8));
+
+    return (idx >= queue->bufferSize) ? 0U : idx;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_QueueOverflow
+****************************************************************************//**
+*
+* Applies the queue overflow policy for a new event which does not fit in the
+* event queue. Runs in a critical section because it modifies the reader
+* index or queued records. An empty queue is restarted at the start of the
+* buffer, so that a record which is smaller than the buffer always fits.
+* Returns the index where the new record can be stored, the buffer size if
+* the event was coalesced into a queued event, or the buffer size plus one if
+* the event has to be dropped.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_QueueOverflow(cy_hpi_master_context_t *context,
+                                            uint8_t slaveIdx,
+                                            uint8_t port,
+                                            uint8_t eventCode,
+                                            const uint8_t *data,
+                                            uint16_t dataLen,
+                                            uint16_t recordLen)
+{
+    cy_hpi_master_event_queue_t *queue = context->ptrEventQueue;
+    uint32_t recordSize = (uint32_t)recordLen + CY_HPI_MASTER_EVT_HDR_SIZE;
+    uint32_t bufferSize = queue->bufferSize;
+    uint32_t headIdx = queue->headIdx;
+    uint32_t tailIdx = queue->tailIdx;
+    uint32_t writeIdx = bufferSize + 1U;
+    uint32_t matchIdx = bufferSize;
+    uint32_t idx;
+    uint8_t *record;
+
+    if (queue->dispatching)
+    {
+        /* The oldest event is owned by the reader. */
+        return writeIdx;
+    }
+
+    if (headIdx == tailIdx)
+    {
+        /* The queue is empty; restart it at the start of the buffer. */
+        queue->headIdx = 0U;
+        queue->tailIdx = 0U;
+        return 0U;
+    }
+
+    if (queue->overflowPolicy == CY_HPI_MASTER_QUEUE_DROP_OLDEST)
+    {
+        while (headIdx != tailIdx)
+        {
+            if (queue->startAddress[headIdx] == CY_HPI_MASTER_EVT_WRAP)
+            {
+                headIdx = 0U;
+            }
+            else
+            {
+                Cy_HPI_Master_QueueReleaseRecord(context, &queue->startAddress[headIdx]);
+                headIdx = Cy_HPI_Master_QueueNextRecord(queue, headIdx);
+                queue->stats.dropped++;
+            }
+            queue->headIdx = (uint16_t)headIdx;
+
+            writeIdx = Cy_HPI_Master_QueueFindSpace(queue, headIdx, tailIdx, recordSize);
+            if (writeIdx != bufferSize)
+            {
+                return writeIdx;
+            }
+        }
+
+        /* Every queued event was dropped; restart the queue. */
+        queue->headIdx = 0U;
+        queue->tailIdx = 0U;
+        writeIdx = 0U;
+    }
+    else if (queue->overflowPolicy == CY_HPI_MASTER_QUEUE_COALESCE)
+    {
+        idx = headIdx;
+        while (idx != tailIdx)
+        {
+            record = &queue->startAddress[idx];
+            if (record[0] == CY_HPI_MASTER_EVT_WRAP)
+            {
+                idx = 0U;
+                continue;
+            }
+
+            if ((record[0] == eventCode) && (record[1] == port) && (record[2] == slaveIdx) &&
+                (record[3] == (uint8_t)recordLen) && (record[4] == (uint8_t)(recordLen >> 8)))
+            {
+                matchIdx = idx;
+            }
+            idx = Cy_HPI_Master_QueueNextRecord(queue, idx);
+        }
+
+        if (matchIdx != bufferSize)
+        {
+            Cy_HPI_Master_QueueReleaseRecord(context, &queue->startAddress[matchIdx]);
+            if ((data != NULL) && (dataLen != 0U))
+            {
+                (void)memcpy(&queue->startAddress[matchIdx + CY_HPI_MASTER_EVT_HDR_SIZE], data, dataLen);
+            }
+            queue->stats.coalesced++;
+            writeIdx = bufferSize;
+        }
+    }
+    else
+    {
+        /* CY_HPI_MASTER_QUEUE_DROP_NEWEST. */
+    }
+
+    return writeIdx;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_EnqueueEvent
+****************************************************************************//**
+*
+* Adds an event and its data to the event queue.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_EnqueueEvent(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveIdx,
+                                                         uint8_t port,
+                                                         uint8_t eventCode,
+                                                         const uint8_t *data,
+                                                         uint16_t dataLen)
+{
+    cy_hpi_master_event_queue_t *queue = context->ptrEventQueue;
+    uint16_t recordLen = dataLen;
+    uint32_t recordSize;
+    uint32_t bufferSize = queue->bufferSize;
+    uint32_t headIdx = queue->headIdx;
+    uint32_t tailIdx = queue->tailIdx;
+    uint32_t writeIdx;
+    uint32_t used;
+    uint32_t intrState;
+    uint8_t *record;
+
+    if (context->ptrTrace != NULL)
+    {
+        /* The interrupt time stamp follows the data. */
+        port      |= CY_HPI_MASTER_EVT_TRACE_FLAG;
+        recordLen += CY_HPI_MASTER_EVT_STAMP_SIZE;
+    }
+    recordSize = (uint32_t)recordLen + CY_HPI_MASTER_EVT_HDR_SIZE;
+
+    writeIdx = Cy_HPI_Master_QueueFindSpace(queue, headIdx, tailIdx, recordSize);
+
+    if ((writeIdx == bufferSize) && (recordSize < bufferSize))
+    {
+        intrState = Cy_SysLib_EnterCriticalSection();
+        writeIdx  = Cy_HPI_Master_QueueOverflow(context, slaveIdx, port, eventCode, data, dataLen, recordLen);
+        headIdx   = queue->headIdx;
+        tailIdx   = queue->tailIdx;
+        Cy_SysLib_ExitCriticalSection(intrState);
+
+        if (writeIdx == bufferSize)
+        {
+            /* Coalesced into a queued event. */
+            return CY_HPI_MASTER_SUCCESS;
+        }
+    }
+
+    if (writeIdx >= bufferSize)
+    {
+        queue->stats.dropped++;
+        return CY_HPI_MASTER_QUEUE_OVERFLOW;
+    }
+
+    record = &queue->startAddress[writeIdx];
+    record[0] = eventCode;
+    record[1] = port;
+    record[2] = slaveIdx;
+    record[3] = (uint8_t)recordLen;
+    record[4] = (uint8_t)(recordLen >> 8);
+
+    if ((data != NULL) && (dataLen != 0U))
+    {
+        (void)memcpy(&record[CY_HPI_MASTER_EVT_HDR_SIZE], data, dataLen);
+    }
+
+    if (context->ptrTrace != NULL)
+    {
+        (void)memcpy(&record[CY_HPI_MASTER_EVT_HDR_SIZE + dataLen],
+                     (const void *)&context->ptrSlaves[slaveIdx].intrTimestamp, CY_HPI_MASTER_EVT_STAMP_SIZE);
+    }
+
+    if (writeIdx != tailIdx)
+    {
+        /* The record did not fit at the end of the buffer. */
+        queue->startAddress[tailIdx] = CY_HPI_MASTER_EVT_WRAP;
+    }
+
+    tailIdx = writeIdx + recordSize;
+    if (tailIdx >= bufferSize)
+    {
+        tailIdx = 0U;
+    }
+
+    /* Publish the record to the reader. */
+    queue->tailIdx = (uint16_t)tailIdx;
+
+    used = (tailIdx >= headIdx) ? (tailIdx - headIdx) : (bufferSize - headIdx + tailIdx);
+    if (used > queue->stats.highWatermark)
+    {
+        queue->stats.highWatermark = (uint16_t)used;
+    }
+    queue->stats.enqueued++;
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ProcessQueue
+****************************************************************************//**
+*
+* Passes the oldest event in the event queue to the application event
+* handler and removes it from the queue. The event data is passed in place
+* and is valid only while the event handler runs.
+*
+* \return
+* true if an event was removed from the queue.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_ProcessQueue(cy_hpi_master_context_t *context)
+{
+    cy_hpi_master_event_queue_t *queue = context->ptrEventQueue;
+    cy_hpi_master_event_t event;
+    uint32_t headIdx;
+    uint8_t *record;
+    uint8_t *eventData;
+    uint8_t *respHdr;
+    uint16_t dataLen;
+    uint32_t timestamp = 0U;
+    uint8_t port;
+
+    /* Claim the oldest event before reading the reader index, so that the
+     * overflow policies do not drop or modify it. */
+    queue->dispatching = true;
+
+    headIdx = queue->headIdx;
+    if ((headIdx != queue->tailIdx) && (queue->startAddress[headIdx] == CY_HPI_MASTER_EVT_WRAP))
+    {
+        headIdx = 0U;
+        queue->headIdx = 0U;
+    }
+
+    if (headIdx == queue->tailIdx)
+    {
+        queue->dispatching = false;
+        return false;
+    }
+
+    record    = &queue->startAddress[headIdx];
+    eventData = &record[CY_HPI_MASTER_EVT_HDR_SIZE];
+    dataLen   = (uint16_t)record[3] | ((uint16_t)record[4] << 8);
+    port      = record[1] & (uint8_t)~(CY_HPI_MASTER_EVT_POOL_FLAG | CY_HPI_MASTER_EVT_TRACE_FLAG);
+
+    if ((record[1] & CY_HPI_MASTER_EVT_TRACE_FLAG) != 0U)
+    {
+        dataLen -= CY_HPI_MASTER_EVT_STAMP_SIZE;
+        (void)memcpy(&timestamp, &eventData[dataLen], CY_HPI_MASTER_EVT_STAMP_SIZE);
+    }
+
+    if ((record[1] & CY_HPI_MASTER_EVT_POOL_FLAG) != 0U)
+    {
+        /* The data is in the event pool block; the block starts with the
+         * response header. */
+        (void)memcpy((void *)&eventData, &record[CY_HPI_MASTER_EVT_HDR_SIZE], sizeof(eventData));
+        respHdr = eventData - CY_HPI_MASTER_EVT_POOL_HDR_SIZE;
+        dataLen = (uint16_t)respHdr[2] | ((uint16_t)respHdr[3] << 8);
+    }
+
+    if ((context->ptrAppCbk->event_handler != NULL) && (record[2] < context->slaveCount))
+    {
+        event.slaveDev  = &context->ptrSlaves[record[2]];
+        event.port      = port;
+        event.eventCode = record[0];
+        event.eventData = eventData;
+        event.dataLen   = dataLen;
+
+        if ((record[1] & CY_HPI_MASTER_EVT_TRACE_FLAG) != 0U)
+        {
+            Cy_HPI_Master_TraceEvent(context, record[2], port, record[0], dataLen, timestamp);
+        }
+
+        (void)context->ptrAppCbk->event_handler(context, &event);
+    }
+    else
+    {
+        Cy_HPI_Master_QueueReleaseRecord(context, record);
+    }
+
+    queue->headIdx     = (uint16_t)Cy_HPI_Master_QueueNextRecord(queue, headIdx);
+    queue->dispatching = false;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetPortCache
+****************************************************************************//**
+*
+* Returns the port register cache entry of a slave device port, or NULL if
+* the cache is disabled or the slave device is not known.
+*
+*******************************************************************************/
+static cy_hpi_master_port_cache_t *Cy_HPI_Master_GetPortCache(cy_hpi_master_context_t *context,
+                                                              uint8_t slaveIdx,
+                                                              uint8_t port)
+{
+    if ((context->ptrPortCache == NULL) || (slaveIdx >= context->slaveCount) ||
+        (port >= CY_HPI_MASTER_CACHE_PORT_COUNT))
+    {
+        return NULL;
+    }
+
+    return &context->ptrPortCache[((uint32_t)slaveIdx * CY_HPI_MASTER_CACHE_PORT_COUNT) + port];
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_InvalidatePortCache
+****************************************************************************//**
+*
+* Clears the valid flags of the cached registers selected by validMask on one
+* port, or on all ports if port is CY_HPI_MASTER_PORT_ALL.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_InvalidatePortCache(cy_hpi_master_context_t *context,
+                                              uint8_t slaveIdx,
+                                              uint8_t port,
+                                              uint8_t validMask)
+{
+    cy_hpi_master_port_cache_t *cache;
+    uint8_t idx;
+
+    for (idx = 0U; idx < CY_HPI_MASTER_CACHE_PORT_COUNT; idx++)
+    {
+        if ((port == CY_HPI_MASTER_PORT_ALL) || (port == idx))
+        {
+            cache = Cy_HPI_Master_GetPortCache(context, slaveIdx, idx);
+            if (cache != NULL)
+            {
+                cache->validMask &= (uint8_t)~validMask;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_CacheEventMask
+****************************************************************************//**
+*
+* Returns the cached registers which an event from a port makes stale.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_CacheEventMask(uint8_t eventCode)
+{
+    uint8_t mask;
+
+    switch (eventCode)
+    {
+        case (uint8_t)CY_HPI_MASTER_EVENT_NEGOTIATION_COMPLETE:
+            /* PD_STATUS, CURRENT_PDO and CURRENT_RDO. */
+            mask = CY_HPI_MASTER_CACHE_PD_STATUS | CY_HPI_MASTER_CACHE_CURRENT_PDO |
+                   CY_HPI_MASTER_CACHE_CURRENT_RDO;
+            break;
+
+        case (uint8_t)CY_HPI_MASTER_EVENT_RESET_COMPLETE:
+        case (uint8_t)CY_HPI_MASTER_EVENT_CONNECT_DETECT:
+        case (uint8_t)CY_HPI_MASTER_EVENT_DISCONNECT_DETECT:
+        case (uint8_t)CY_HPI_MASTER_EVENT_SWAP_COMPLETE:
+        case (uint8_t)CY_HPI_MASTER_EVENT_HARD_RESET_RECEIVED:
+        case (uint8_t)CY_HPI_MASTER_EVENT_HARD_RESET_SENT:
+        case (uint8_t)CY_HPI_MASTER_EVENT_ERROR_RECOVERY:
+            mask = CY_HPI_MASTER_CACHE_ALL;
+            break;
+
+        default:
+            mask = 0U;
+            break;
+    }
+
+    return mask;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_UpdatePollInterval
+****************************************************************************//**
+*
+* Adapts the poll interval of a slave device without an interrupt GPIO after
+* a poll, and restarts its poll timer.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_UpdatePollInterval(cy_hpi_master_context_t *context,
+                                             cy_hpi_master_slave_dev_t *slaveDev,
+                                             bool intrSeen)
+{
+    uint32_t interval = (uint32_t)slaveDev->pollInterval << 1;
+
+    if ((intrSeen) || (interval < context->pollIntervalMin))
+    {
+        interval = context->pollIntervalMin;
+    }
+    if (interval > context->pollIntervalMax)
+    {
+        interval = context->pollIntervalMax;
+    }
+
+    slaveDev->pollInterval  = (uint16_t)interval;
+    slaveDev->pollCountdown = (uint16_t)interval;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_XferAsyncSupported
+****************************************************************************//**
+*
+* Checks whether the application provides a non-blocking I2C backend. Like
+* the blocking register reads, the non-blocking backend is not used if its
+* reads do not use a repeated start and i2c_master_write_read is provided.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_XferAsyncSupported(cy_hpi_master_context_t *context)
+{
+    cy_hpi_master_app_cbk_t *appCbk = context->ptrAppCbk;
+
+    return ((appCbk->i2c_master_read_async != NULL) && (appCbk->i2c_master_write_async != NULL) &&
+            (((appCbk->i2cCaps & CY_HPI_MASTER_I2C_CAP_REPEATED_START) != 0U) ||
+             (appCbk->i2c_master_write_read == NULL)));
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetBus
+****************************************************************************//**
+*
+* Returns the I2C bus of a slave device, or NULL if the slave device is
+* quarantined. Slave addresses which are not registered
+* (CY_HPI_MASTER_UNKNOWN_SLAVE_IDX) are accessed on the first bus.
+*
+*******************************************************************************/
+static cy_hpi_master_bus_t *Cy_HPI_Master_GetBus(cy_hpi_master_context_t *context, uint8_t slaveIdx)
+{
+    cy_hpi_master_slave_dev_t *slaveDev;
+
+    if (slaveIdx < context->slaveCount)
+    {
+        slaveDev = &context->ptrSlaves[slaveIdx];
+        if (slaveDev->health == CY_HPI_MASTER_HEALTH_QUARANTINED)
+        {
+            return NULL;
+        }
+        return &context->ptrBuses[slaveDev->busIdx];
+    }
+
+    return &context->ptrBuses[0];
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SlaveLookup
+****************************************************************************//**
+*
+* Returns the index of the slave device accessed by address through a public
+* API, or CY_HPI_MASTER_UNKNOWN_SLAVE_IDX. The slave device is only looked up
+* if it can be on another bus, be quarantined or be traced; the library
+* itself accesses its slave devices by index.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_SlaveLookup(cy_hpi_master_context_t *context, uint8_t slaveAddr)
+{
+    if ((context->busCount > 1U) || (context->unhealthyCount != 0U) || (context->ptrTrace != NULL))
+    {
+        return Cy_HPI_Master_GetSlaveIndexByAddr(context, slaveAddr);
+    }
+
+    return CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_I2cRead
+****************************************************************************//**
+*
+* Performs a blocking register read on a bus. The read callback is used if
+* it writes the register address with a repeated start; otherwise the
+* combined write-read callback is used if provided, so that no other master
+* can access the slave device between the address write and the data read.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_I2cRead(cy_hpi_master_context_t *context,
+                                  cy_hpi_master_bus_t *bus,
+                                  uint8_t slaveAddr,
+                                  uint8_t *regAddr,
+                                  uint8_t *readBuff,
+                                  uint16_t readLen)
+{
+    cy_hpi_master_app_cbk_t *appCbk = context->ptrAppCbk;
+
+    if ((appCbk->i2c_master_write_read != NULL) &&
+        ((appCbk->i2c_master_read == NULL) || ((appCbk->i2cCaps & CY_HPI_MASTER_I2C_CAP_REPEATED_START) == 0U)))
+    {
+        return appCbk->i2c_master_write_read(bus->ptrScbBase, slaveAddr, regAddr, 2U, readBuff, readLen,
+                                             bus->ptrI2cContext);
+    }
+
+    return appCbk->i2c_master_read(bus->ptrScbBase, slaveAddr, readBuff, readLen, regAddr, 2U,
+                                   bus->ptrI2cContext);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_XferStart
+****************************************************************************//**
+*
+* Starts the next queued asynchronous transaction of a bus if the bus is
+* free. A transaction which cannot be started is completed with I2C failure
+* status.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_XferStart(cy_hpi_master_context_t *context, cy_hpi_master_bus_t *bus)
+{
+    cy_hpi_master_xfer_t *xfer;
+    uint32_t intrState;
+    bool started;
+
+    for (;;)
+    {
+        intrState = Cy_SysLib_EnterCriticalSection();
+        if ((bus->xferBusy) || (bus->xferHold) || (bus->xferDone >= bus->xferCount))
+        {
+            Cy_SysLib_ExitCriticalSection(intrState);
+            return;
+        }
+        bus->xferBusy = true;
+        xfer = &bus->ptrXferQueue[((uint32_t)bus->xferHead + bus->xferDone) % bus->xferQueueSize];
+        Cy_SysLib_ExitCriticalSection(intrState);
+
+        if (xfer->isWrite)
+        {
+            started = context->ptrAppCbk->i2c_master_write_async(bus->ptrScbBase, xfer->slaveAddr,
+                                                                 xfer->buffer, xfer->length, xfer->regAddr,
+                                                                 2U, bus->ptrI2cContext);
+        }
+        else
+        {
+            started = context->ptrAppCbk->i2c_master_read_async(bus->ptrScbBase, xfer->slaveAddr,
+                                                                xfer->buffer, xfer->length, xfer->regAddr,
+                                                                2U, bus->ptrI2cContext);
+        }
+
+        if (started)
+        {
+            return;
+        }
+
+        intrState = Cy_SysLib_EnterCriticalSection();
+        xfer->status = CY_HPI_MASTER_I2C_FAILURE;
+        bus->xferDone++;
+        bus->xferBusy = false;
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BusAcquire
+****************************************************************************//**
+*
+* Holds the asynchronous transaction queue of a bus and waits for the
+* transfer on the bus to finish, so that a blocking transfer can be done.
+* The wait is bounded by CY_HPI_MASTER_XFER_TIMEOUT_US; on timeout the hold is
+* dropped again and CY_HPI_MASTER_TIMEOUT is returned. The previous hold state
+* is returned through prevHold to be passed to Cy_HPI_Master_BusRelease.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_BusAcquire(cy_hpi_master_context_t *context,
+                                                       cy_hpi_master_bus_t *bus,
+                                                       bool *prevHold)
+{
+    uint32_t waitUs = 0U;
+
+    *prevHold = bus->xferHold;
+
+    if ((bus->ptrXferQueue != NULL) && (Cy_HPI_Master_XferAsyncSupported(context)))
+    {
+        bus->xferHold = true;
+        while (bus->xferBusy)
+        {
+            if (waitUs >= CY_HPI_MASTER_XFER_TIMEOUT_US)
+            {
+                bus->xferHold = *prevHold;
+                return CY_HPI_MASTER_TIMEOUT;
+            }
+            Cy_SysLib_DelayUs(1U);
+            waitUs++;
+        }
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BusRelease
+****************************************************************************//**
+*
+* Restores the queue hold state of a bus and restarts its asynchronous
+* transactions.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_BusRelease(cy_hpi_master_context_t *context, cy_hpi_master_bus_t *bus, bool prevHold)
+{
+    if ((bus->ptrXferQueue != NULL) && (Cy_HPI_Master_XferAsyncSupported(context)))
+    {
+        bus->xferHold = prevHold;
+        if (!prevHold)
+        {
+            Cy_HPI_Master_XferStart(context, bus);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_Quarantine
+****************************************************************************//**
+*
+* Quarantines a slave device which failed too many register accesses or a
+* probe, and starts its backoff timer. The backoff time doubles after each
+* failed probe.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_Quarantine(cy_hpi_master_context_t *context, uint8_t slaveIdx)
+{
+    cy_hpi_master_slave_dev_t *slaveDev = &context->ptrSlaves[slaveIdx];
+    uint32_t backoff;
+
+    if (slaveDev->health == CY_HPI_MASTER_HEALTH_OK)
+    {
+        backoff = context->backoffMin;
+        context->unhealthyCount++;
+    }
+    else
+    {
+        backoff = (uint32_t)slaveDev->backoff << 1;
+        if (backoff > context->backoffMax)
+        {
+            backoff = context->backoffMax;
+        }
+    }
+
+    Cy_HPI_Master_ClearPending(context, slaveIdx);
+    Cy_HPI_Master_SetPriority(context, slaveIdx, false);
+
+    /* The countdown is set first, as Cy_HPI_Master_PollTimerHandler only
+     * counts down quarantined slave devices. */
+    slaveDev->failCount        = 0U;
+    slaveDev->backoff          = (uint16_t)backoff;
+    slaveDev->backoffCountdown = (uint16_t)backoff;
+    slaveDev->health           = CY_HPI_MASTER_HEALTH_QUARANTINED;
+
+    Cy_HPI_Master_ReportError(context, slaveDev, CY_HPI_MASTER_SLAVE_QUARANTINED);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BusRecover
+****************************************************************************//**
+*
+* Releases the I2C bus of a slave device if SDA is held low, by clocking SCL
+* until SDA is released and generating a STOP condition. The SCL and SDA pins
+* are switched to GPIO for the sequence and restored afterwards.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_BusRecover(cy_hpi_master_context_t *context, cy_hpi_master_slave_dev_t *slaveDev)
+{
+    cy_hpi_master_bus_t *bus = &context->ptrBuses[slaveDev->busIdx];
+    en_hsiom_sel_t sclHsiom;
+    en_hsiom_sel_t sdaHsiom;
+    uint32_t sclDriveMode;
+    uint32_t sdaDriveMode;
+    uint32_t clocks;
+    bool prevHold;
+    bool released;
+
+    if ((bus->sclPort == NULL) || (bus->sdaPort == NULL))
+    {
+        return;
+    }
+
+    if (Cy_HPI_Master_BusAcquire(context, bus, &prevHold) != CY_HPI_MASTER_SUCCESS)
+    {
+        return;
+    }
+
+    if (Cy_GPIO_Read(bus->sdaPort, bus->sdaPin) == 0U)
+    {
+        sclHsiom     = Cy_GPIO_GetHSIOM(bus->sclPort, bus->sclPin);
+        sdaHsiom     = Cy_GPIO_GetHSIOM(bus->sdaPort, bus->sdaPin);
+        sclDriveMode = Cy_GPIO_GetDrivemode(bus->sclPort, bus->sclPin);
+        sdaDriveMode = Cy_GPIO_GetDrivemode(bus->sdaPort, bus->sdaPin);
+
+        Cy_GPIO_Write(bus->sclPort, bus->sclPin, 1U);
+        Cy_GPIO_Write(bus->sdaPort, bus->sdaPin, 1U);
+        Cy_GPIO_SetDrivemode(bus->sclPort, bus->sclPin, CY_GPIO_DM_OD_DRIVESLOW);
+        Cy_GPIO_SetDrivemode(bus->sdaPort, bus->sdaPin, CY_GPIO_DM_OD_DRIVESLOW);
+        Cy_GPIO_SetHSIOM(bus->sclPort, bus->sclPin, HSIOM_SEL_GPIO);
+        Cy_GPIO_SetHSIOM(bus->sdaPort, bus->sdaPin, HSIOM_SEL_GPIO);
+
+        /* Clock out the rest of the byte the slave device is sending. */
+        for (clocks = 0U; (clocks < CY_HPI_MASTER_RECOVERY_CLOCKS) &&
+                          (Cy_GPIO_Read(bus->sdaPort, bus->sdaPin) == 0U); clocks++)
+        {
+            Cy_GPIO_Write(bus->sclPort, bus->sclPin, 0U);
+            Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+            Cy_GPIO_Write(bus->sclPort, bus->sclPin, 1U);
+            Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+        }
+
+        /* STOP condition: SDA rises while SCL is high. */
+        Cy_GPIO_Write(bus->sclPort, bus->sclPin, 0U);
+        Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+        Cy_GPIO_Write(bus->sdaPort, bus->sdaPin, 0U);
+        Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+        Cy_GPIO_Write(bus->sclPort, bus->sclPin, 1U);
+        Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+        Cy_GPIO_Write(bus->sdaPort, bus->sdaPin, 1U);
+        Cy_SysLib_DelayUs(CY_HPI_MASTER_RECOVERY_HALF_PERIOD_US);
+
+        released = (Cy_GPIO_Read(bus->sdaPort, bus->sdaPin) != 0U);
+
+        Cy_GPIO_SetHSIOM(bus->sclPort, bus->sclPin, sclHsiom);
+        Cy_GPIO_SetHSIOM(bus->sdaPort, bus->sdaPin, sdaHsiom);
+        Cy_GPIO_SetDrivemode(bus->sclPort, bus->sclPin, sclDriveMode);
+        Cy_GPIO_SetDrivemode(bus->sdaPort, bus->sdaPin, sdaDriveMode);
+
+        Cy_HPI_Master_ReportError(context, slaveDev,
+                                  released ? CY_HPI_MASTER_BUS_RECOVERED : CY_HPI_MASTER_BUS_STUCK);
+    }
+
+    Cy_HPI_Master_BusRelease(context, bus, prevHold);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SlaveFailed
+****************************************************************************//**
+*
+* Records a failed register access of a slave device. The bus of the slave
+* device is recovered, and the slave device is quarantined when a probe fails
+* or failThreshold accesses fail without a successful service in between.
+* slaveIdx is CY_HPI_MASTER_UNKNOWN_SLAVE_IDX if it was not looked up.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_SlaveFailed(cy_hpi_master_context_t *context, uint8_t slaveIdx, uint8_t slaveAddr)
+{
+    cy_hpi_master_slave_dev_t *slaveDev;
+
+    if (slaveIdx == CY_HPI_MASTER_UNKNOWN_SLAVE_IDX)
+    {
+        slaveIdx = Cy_HPI_Master_GetSlaveIndexByAddr(context, slaveAddr);
+    }
+    if (slaveIdx >= context->slaveCount)
+    {
+        return;
+    }
+
+    slaveDev = &context->ptrSlaves[slaveIdx];
+    if (slaveDev->health == CY_HPI_MASTER_HEALTH_QUARANTINED)
+    {
+        return;
+    }
+
+    Cy_HPI_Master_BusRecover(context, slaveDev);
+
+    /* Stop accessing a slave device which does not respond. A polled slave
+     * device restarts its poll timer when a probe succeeds. */
+    slaveDev->failCount++;
+    if ((slaveDev->health == CY_HPI_MASTER_HEALTH_PROBING) ||
+        (slaveDev->failCount >= context->failThreshold))
+    {
+        Cy_HPI_Master_Quarantine(context, slaveIdx);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_XferEnqueue
+****************************************************************************//**
+*
+* Adds a transaction to the asynchronous transaction queue of the bus of the
+* slave device and starts it if the bus is free.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_XferEnqueue(cy_hpi_master_context_t *context,
+                                                        uint8_t slaveIdx,
+                                                        uint8_t slaveAddr,
+                                                        uint16_t regAddress,
+                                                        uint8_t *buffer,
+                                                        uint16_t length,
+                                                        bool isWrite,
+                                                        cy_hpi_master_xfer_cbk_t cbk,
+                                                        void *tag)
+{
+    cy_hpi_master_bus_t *bus;
+    cy_hpi_master_xfer_t *xfer;
+    uint32_t intrState;
+
+    if (buffer == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    bus = Cy_HPI_Master_GetBus(context, slaveIdx);
+    if (bus == NULL)
+    {
+        return CY_HPI_MASTER_SLAVE_QUARANTINED;
+    }
+
+    if (bus->ptrXferQueue == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (bus->xferCount >= bus->xferQueueSize)
+    {
+        Cy_SysLib_ExitCriticalSection(intrState);
+        return CY_HPI_MASTER_QUEUE_OVERFLOW;
+    }
+
+    xfer             = &bus->ptrXferQueue[bus->xferTail];
+    xfer->cbk        = cbk;
+    xfer->tag        = tag;
+    xfer->buffer     = buffer;
+    xfer->length     = length;
+    xfer->regAddr[0] = (uint8_t)regAddress;
+    xfer->regAddr[1] = (uint8_t)(regAddress >> 8);
+    xfer->slaveAddr  = slaveAddr;
+    xfer->slaveIdx   = slaveIdx;
+    xfer->isWrite    = isWrite;
+    xfer->status     = CY_HPI_MASTER_FAILURE;
+    xfer->timestamp  = Cy_HPI_Master_TraceTime(context);
+
+    bus->xferTail = (uint8_t)(((uint32_t)bus->xferTail + 1U) % bus->xferQueueSize);
+    bus->xferCount++;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (Cy_HPI_Master_XferAsyncSupported(context))
+    {
+        Cy_HPI_Master_XferStart(context, bus);
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ProcessXfers
+****************************************************************************//**
+*
+* Executes the queued transactions of a bus with the blocking I2C callbacks
+* when no non-blocking backend is provided, and calls the completion
+* callbacks of the completed transactions.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ProcessXfers(cy_hpi_master_context_t *context, cy_hpi_master_bus_t *bus)
+{
+    cy_hpi_master_xfer_t *xfer;
+    cy_hpi_master_xfer_t done;
+    cy_hpi_master_xfer_cbk_t cbk;
+    cy_hpi_master_status_t status;
+    uint32_t intrState;
+    void *tag;
+    bool result;
+
+    if (bus->ptrXferQueue == NULL)
+    {
+        return;
+    }
+
+    if (!Cy_HPI_Master_XferAsyncSupported(context))
+    {
+        while (bus->xferDone < bus->xferCount)
+        {
+            xfer = &bus->ptrXferQueue[((uint32_t)bus->xferHead + bus->xferDone) % bus->xferQueueSize];
+            if (xfer->isWrite)
+            {
+                result = context->ptrAppCbk->i2c_master_write(bus->ptrScbBase, xfer->slaveAddr,
+                                                              xfer->buffer, xfer->length, xfer->regAddr,
+                                                              2U, bus->ptrI2cContext);
+            }
+            else
+            {
+                result = Cy_HPI_Master_I2cRead(context, bus, xfer->slaveAddr, xfer->regAddr,
+                                               xfer->buffer, xfer->length);
+            }
+            xfer->status = result ? CY_HPI_MASTER_SUCCESS : CY_HPI_MASTER_I2C_FAILURE;
+            bus->xferDone++;
+        }
+    }
+
+    while (bus->xferDone != 0U)
+    {
+        /* Release the entry before calling the callback so that it can queue
+         * the next transaction. */
+        intrState = Cy_SysLib_EnterCriticalSection();
+        xfer   = &bus->ptrXferQueue[bus->xferHead];
+        cbk    = xfer->cbk;
+        tag    = xfer->tag;
+        status = xfer->status;
+        done   = *xfer;
+        bus->xferHead = (uint8_t)(((uint32_t)bus->xferHead + 1U) % bus->xferQueueSize);
+        bus->xferCount--;
+        bus->xferDone--;
+        Cy_SysLib_ExitCriticalSection(intrState);
+
+        if (context->ptrTrace != NULL)
+        {
+            Cy_HPI_Master_TraceXfer(context, done.slaveIdx, done.slaveAddr,
+                                    (uint16_t)done.regAddr[0] | ((uint16_t)done.regAddr[1] << 8), done.length,
+                                    CY_HPI_MASTER_TRACE_FLAG_ASYNC |
+                                    (done.isWrite ? CY_HPI_MASTER_TRACE_FLAG_WRITE : 0U) |
+                                    ((status == CY_HPI_MASTER_SUCCESS) ? 0U : CY_HPI_MASTER_TRACE_FLAG_ERROR),
+                                    done.timestamp);
+        }
+
+        if (status == CY_HPI_MASTER_I2C_FAILURE)
+        {
+            Cy_HPI_Master_SlaveFailed(context, done.slaveIdx, done.slaveAddr);
+        }
+
+        if (cbk != NULL)
+        {
+            cbk(context, status, tag);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GroupWriteDone
+****************************************************************************//**
+*
+* Completion callback of the writes queued by Cy_HPI_Master_GroupWrite.
+* Stores the status in the slave status entry passed as the tag.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_GroupWriteDone(cy_hpi_master_context_t *context,
+                                         cy_hpi_master_status_t status,
+                                         void *tag)
+{
+    (void)context;
+
+    *(cy_hpi_master_status_t *)tag = status;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GroupWritePending
+****************************************************************************//**
+*
+* Returns the number of writes queued by Cy_HPI_Master_GroupWrite which are
+* not completed yet. Their slave status entry holds CY_HPI_MASTER_TIMEOUT
+* until the completion callback stores the result.
+*
+*******************************************************************************/
+static uint32_t Cy_HPI_Master_GroupWritePending(const cy_hpi_master_status_t *slaveStatus,
+                                                uint8_t count)
+{
+    uint32_t pending = 0U;
+    uint8_t idx;
+
+    for (idx = 0U; idx < count; idx++)
+    {
+        if (slaveStatus[idx] == CY_HPI_MASTER_TIMEOUT)
+        {
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GroupWriteDetach
+****************************************************************************//**
+*
+* Removes the completion callback of the writes queued by
+* Cy_HPI_Master_GroupWrite which timed out, so that their late completion
+* does not write to the slave status array of the caller.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_GroupWriteDetach(cy_hpi_master_context_t *context,
+                                           const cy_hpi_master_status_t *slaveStatus,
+                                           uint8_t count)
+{
+    cy_hpi_master_xfer_t *xfer;
+    cy_hpi_master_bus_t *bus;
+    uint32_t intrState;
+    uint32_t idx;
+    uint8_t busIdx;
+
+    for (busIdx = 0U; busIdx < context->busCount; busIdx++)
+    {
+        bus = &context->ptrBuses[busIdx];
+        if (bus->ptrXferQueue == NULL)
+        {
+            continue;
+        }
+
+        intrState = Cy_SysLib_EnterCriticalSection();
+        for (idx = 0U; idx < bus->xferCount; idx++)
+        {
+            xfer = &bus->ptrXferQueue[((uint32_t)bus->xferHead + idx) % bus->xferQueueSize];
+            if ((xfer->cbk == Cy_HPI_Master_GroupWriteDone) &&
+                ((const cy_hpi_master_status_t *)xfer->tag >= slaveStatus) &&
+                ((const cy_hpi_master_status_t *)xfer->tag < &slaveStatus[count]))
+            {
+                xfer->cbk = NULL;
+            }
+        }
+        Cy_SysLib_ExitCriticalSection(intrState);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BusRead
+****************************************************************************//**
+*
+* Performs a blocking register read from a slave device on the given bus.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_BusRead(cy_hpi_master_context_t *context,
+                                                    cy_hpi_master_bus_t *bus,
+                                                    uint8_t slaveIdx,
+                                                    uint8_t slaveAddr,
+                                                    uint16_t regAddress,
+                                                    uint8_t *readBuff,
+                                                    uint16_t readLen)
+{
+    uint32_t timestamp = Cy_HPI_Master_TraceTime(context);
+    uint8_t regAddr[2];
+    bool prevHold;
+    bool result;
+
+    regAddr[0] = (uint8_t)regAddress;
+    regAddr[1] = (uint8_t)(regAddress >> 8);
+
+    if (Cy_HPI_Master_BusAcquire(context, bus, &prevHold) != CY_HPI_MASTER_SUCCESS)
+    {
+        return CY_HPI_MASTER_TIMEOUT;
+    }
+    result = Cy_HPI_Master_I2cRead(context, bus, slaveAddr, regAddr, readBuff, readLen);
+    Cy_HPI_Master_BusRelease(context, bus, prevHold);
+
+    if (context->ptrTrace != NULL)
+    {
+        Cy_HPI_Master_TraceXfer(context, slaveIdx, slaveAddr, regAddress, readLen,
+                                result ? 0U : CY_HPI_MASTER_TRACE_FLAG_ERROR, timestamp);
+    }
+
+    if (!result)
+    {
+        Cy_HPI_Master_SlaveFailed(context, slaveIdx, slaveAddr);
+        return CY_HPI_MASTER_I2C_FAILURE;
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SlaveRegRead
+****************************************************************************//**
+*
+* Performs a blocking register read from a slave device. slaveIdx is
+* CY_HPI_MASTER_UNKNOWN_SLAVE_IDX for an address which is not registered or
+* was not looked up.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_SlaveRegRead(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveIdx,
+                                                         uint8_t slaveAddr,
+                                                         uint16_t regAddress,
+                                                         uint8_t *readBuff,
+                                                         uint16_t readLen)
+{
+    cy_hpi_master_bus_t *bus;
+
+    if (readBuff == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if ((context->ptrAppCbk->i2c_master_read == NULL) && (context->ptrAppCbk->i2c_master_write_read == NULL))
+    {
+        return CY_HPI_MASTER_I2C_FAILURE;
+    }
+
+    bus = Cy_HPI_Master_GetBus(context, slaveIdx);
+    if (bus == NULL)
+    {
+        return CY_HPI_MASTER_SLAVE_QUARANTINED;
+    }
+
+    return Cy_HPI_Master_BusRead(context, bus, slaveIdx, slaveAddr, regAddress, readBuff, readLen);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SlaveRegWrite
+****************************************************************************//**
+*
+* Performs a blocking register write to a slave device. slaveIdx is
+* CY_HPI_MASTER_UNKNOWN_SLAVE_IDX for an address which is not registered or
+* was not looked up.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_SlaveRegWrite(cy_hpi_master_context_t *context,
+                                                          uint8_t slaveIdx,
+                                                          uint8_t slaveAddr,
+                                                          uint16_t regAddress,
+                                                          void *writeBuff,
+                                                          uint16_t writeLen)
+{
+    cy_hpi_master_bus_t *bus;
+    uint32_t timestamp;
+    uint8_t regAddr[2];
+    bool prevHold;
+    bool result;
+
+    if (context->ptrAppCbk->i2c_master_write == NULL)
+    {
+        return CY_HPI_MASTER_I2C_FAILURE;
+    }
+
+    regAddr[0] = (uint8_t)regAddress;
+    regAddr[1] = (uint8_t)(regAddress >> 8);
+
+    bus = Cy_HPI_Master_GetBus(context, slaveIdx);
+    if (bus == NULL)
+    {
+        return CY_HPI_MASTER_SLAVE_QUARANTINED;
+    }
+
+    timestamp = Cy_HPI_Master_TraceTime(context);
+    if (Cy_HPI_Master_BusAcquire(context, bus, &prevHold) != CY_HPI_MASTER_SUCCESS)
+    {
+        return CY_HPI_MASTER_TIMEOUT;
+    }
+    result = context->ptrAppCbk->i2c_master_write(bus->ptrScbBase, slaveAddr, (uint8_t *)writeBuff,
+                                                  writeLen, regAddr, 2U, bus->ptrI2cContext);
+    Cy_HPI_Master_BusRelease(context, bus, prevHold);
+
+    if (context->ptrTrace != NULL)
+    {
+        Cy_HPI_Master_TraceXfer(context, slaveIdx, slaveAddr, regAddress, writeLen, CY_HPI_MASTER_TRACE_FLAG_WRITE |
+                                (result ? 0U : CY_HPI_MASTER_TRACE_FLAG_ERROR), timestamp);
+    }
+
+    if (!result)
+    {
+        Cy_HPI_Master_SlaveFailed(context, slaveIdx, slaveAddr);
+        return CY_HPI_MASTER_I2C_FAILURE;
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PdResponseRead
+****************************************************************************//**
+*
+* Reads from the PD response registers of a slave device port.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_PdResponseRead(cy_hpi_master_context_t *context,
+                                                           uint8_t slaveIdx,
+                                                           uint8_t slaveAddr,
+                                                           uint8_t port,
+                                                           uint16_t offset,
+                                                           void *readData,
+                                                           uint16_t readLen)
+{
+    return Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr,
+                                      (uint16_t)(((uint16_t)port + 1U) << 12) |
+                                      ((offset + CY_HPI_MASTER_PD_RESP_READ_OFFSET) & 0x0FFFU),
+                                      (uint8_t *)readData, readLen);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ReadResponse
+****************************************************************************//**
+*
+* Reads the response header of a port and, if respPrefetchLen is set, the
+* first response data bytes in the same I2C transfer. The header and the
+* prefetched data are read into respBuff, the header is copied to respHdr,
+* and the length of the prefetched data is returned in readLen.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_ReadResponse(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveIdx,
+                                                         uint8_t port,
+                                                         uint8_t *respBuff,
+                                                         uint16_t respBuffLen,
+                                                         uint8_t *respHdr,
+                                                         uint16_t *readLen)
+{
+    cy_hpi_master_status_t status;
+    uint16_t dataLen;
+    uint16_t prefetch = context->respPrefetchLen;
+    uint8_t slaveAddr = context->ptrSlaves[slaveIdx].slaveAddr;
+
+    *readLen = 0U;
+
+    if (respBuffLen <= CY_HPI_MASTER_RESP_HDR_SIZE)
+    {
+        prefetch = 0U;
+    }
+    else if (prefetch > (respBuffLen - CY_HPI_MASTER_RESP_HDR_SIZE))
+    {
+        prefetch = respBuffLen - CY_HPI_MASTER_RESP_HDR_SIZE;
+    }
+    else
+    {
+        /* Prefetch length fits in the response buffer. */
+    }
+
+    if (prefetch == 0U)
+    {
+        return Cy_HPI_Master_PdResponseRead(context, slaveIdx, slaveAddr, port, 0U,
+                                            respHdr, CY_HPI_MASTER_RESP_HDR_SIZE);
+    }
+
+    /* The response data follows the header in the slave register map. */
+    status = Cy_HPI_Master_PdResponseRead(context, slaveIdx, slaveAddr, port, 0U, respBuff,
+                                          CY_HPI_MASTER_RESP_HDR_SIZE + prefetch);
+    if (status == CY_HPI_MASTER_SUCCESS)
+    {
+        (void)memcpy(respHdr, respBuff, CY_HPI_MASTER_RESP_HDR_SIZE);
+
+        dataLen = (uint16_t)respHdr[2] | ((uint16_t)respHdr[3] << 8);
+        *readLen = (dataLen < prefetch) ? dataLen : prefetch;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_HandlePortInterrupt
+****************************************************************************//**
+*
+* Reads the response or event reported on a slave port. Responses are passed
+* to the application event handler immediately; asynchronous events are added
+* to the event queue. With CY_HPI_MASTER_SCHED_FAULT_PRIORITY, fault events
+* are also passed to the event handler immediately.
+*
+* \return
+* true if the port interrupt has been handled and can be cleared.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_HandlePortInterrupt(cy_hpi_master_context_t *context,
+                                              uint8_t slaveIdx,
+                                              uint8_t port,
+                                              bool *faultSeen)
+{
+    cy_hpi_master_slave_dev_t *slaveDev = &context->ptrSlaves[slaveIdx];
+    cy_hpi_master_app_cbk_t *appCbk = context->ptrAppCbk;
+    cy_hpi_master_evt_pool_t *pool = NULL;
+    uint8_t *block = Cy_HPI_Master_PoolAlloc(context, 0U, &pool);
+    uint8_t *largeBlock;
+    uint8_t *respData;
+    cy_hpi_master_status_t status;
+    cy_hpi_master_event_t event;
+    uint8_t respHdr[CY_HPI_MASTER_RESP_HDR_SIZE] = {0U};
+    uint16_t dataCapacity;
+    uint16_t dataLen;
+    uint16_t readLen;
+    bool handled = false;
+
+    if (block != NULL)
+    {
+        /* Read the data directly into the event pool block, after the
+         * response header. */
+        status = Cy_HPI_Master_ReadResponse(context, slaveIdx, port, block,
+                                            pool->blockSize, respHdr, &readLen);
+        respData     = &block[CY_HPI_MASTER_EVT_POOL_HDR_SIZE];
+        dataCapacity = pool->blockSize - CY_HPI_MASTER_EVT_POOL_HDR_SIZE;
+        (void)memcpy(block, respHdr, CY_HPI_MASTER_RESP_HDR_SIZE);
+    }
+    else
+    {
+        status = Cy_HPI_Master_ReadResponse(context, slaveIdx, port, context->ptrRespBuff,
+                                            context->respBuffLen, respHdr, &readLen);
+        respData     = context->ptrRespBuff;
+        dataCapacity = context->respBuffLen;
+        if (readLen != 0U)
+        {
+            (void)memmove(respData, &respData[CY_HPI_MASTER_RESP_HDR_SIZE], readLen);
+        }
+    }
+
+    if (status == CY_HPI_MASTER_SUCCESS)
+    {
+        Cy_HPI_Master_InvalidatePortCache(context, slaveIdx, port, Cy_HPI_Master_CacheEventMask(respHdr[0]));
+
+        dataLen = (uint16_t)respHdr[2] | ((uint16_t)respHdr[3] << 8);
+
+        if ((block != NULL) && (dataLen > dataCapacity))
+        {
+            /* Move the header and the prefetched data to a block of the size
+             * class of the event, or to ptrRespBuff if none is free. */
+            largeBlock = Cy_HPI_Master_PoolAlloc(context, dataLen, &pool);
+            if (largeBlock != NULL)
+            {
+                (void)memcpy(largeBlock, block, (uint32_t)CY_HPI_MASTER_EVT_POOL_HDR_SIZE + readLen);
+                respData     = &largeBlock[CY_HPI_MASTER_EVT_POOL_HDR_SIZE];
+                dataCapacity = pool->blockSize - CY_HPI_MASTER_EVT_POOL_HDR_SIZE;
+            }
+            else
+            {
+                if (readLen > context->respBuffLen)
+                {
+                    /* The data does not fit in ptrRespBuff and is dropped. */
+                    readLen = context->respBuffLen;
+                }
+                (void)memcpy(context->ptrRespBuff, respData, readLen);
+                respData     = context->ptrRespBuff;
+                dataCapacity = context->respBuffLen;
+            }
+
+            Cy_HPI_Master_EventRelease(context, &block[CY_HPI_MASTER_EVT_POOL_HDR_SIZE]);
+            block = largeBlock;
+        }
+
+        if ((dataLen == 0U) || (dataLen > dataCapacity))
+        {
+            /* Data that does not fit in the response buffer is dropped. */
+            dataLen  = 0U;
+            respData = NULL;
+        }
+        else if (dataLen > readLen)
+        {
+            /* Read the part of the data which was not prefetched. */
+            (void)memset(&respData[readLen], 0, (uint32_t)dataCapacity - readLen);
+            status = Cy_HPI_Master_PdResponseRead(context, slaveIdx, slaveDev->slaveAddr, port,
+                                                  CY_HPI_MASTER_RESP_HDR_SIZE + readLen,
+                                                  &respData[readLen], dataLen - readLen);
+        }
+        else
+        {
+            /* All the data was read with the header. */
+        }
+
+        if (status == CY_HPI_MASTER_SUCCESS)
+        {
+            if (Cy_HPI_Master_IsFaultEvent(respHdr[0]))
+            {
+                *faultSeen = true;
+            }
+
+            if ((block != NULL) && (respData == NULL))
+            {
+                /* No data to pass in the block. */
+                Cy_HPI_Master_EventRelease(context, &block[CY_HPI_MASTER_EVT_POOL_HDR_SIZE]);
+                block = NULL;
+            }
+
+            if (((respHdr[0] & 0x80U) != 0U) &&
+                (((context->schedFlags & CY_HPI_MASTER_SCHED_FAULT_PRIORITY) == 0U) ||
+                 (!Cy_HPI_Master_IsFaultEvent(respHdr[0]))))
+            {
+                /* Asynchronous event: queue it for Cy_HPI_Master_Task. */
+                if (block != NULL)
+                {
+                    status = Cy_HPI_Master_EnqueueEvent(context, slaveIdx, port | CY_HPI_MASTER_EVT_POOL_FLAG,
+                                                        respHdr[0], (const uint8_t *)&respData,
+                                                        (uint16_t)sizeof(respData));
+                    if (status == CY_HPI_MASTER_SUCCESS)
+                    {
+                        block = NULL;
+                    }
+                }
+                else
+                {
+                    status = Cy_HPI_Master_EnqueueEvent(context, slaveIdx, port, respHdr[0],
+                                                        respData, dataLen);
+                }
+                handled = true;
+            }
+            else if (appCbk->event_handler != NULL)
+            {
+                event.slaveDev  = slaveDev;
+                event.port      = port;
+                event.eventCode = respHdr[0];
+                event.eventData = respData;
+                event.dataLen   = dataLen;
+
+                if (context->ptrTrace != NULL)
+                {
+                    Cy_HPI_Master_TraceEvent(context, slaveIdx, port, respHdr[0], dataLen, slaveDev->intrTimestamp);
+                }
+
+                /* The application owns the event pool block from here. */
+                block   = NULL;
+                handled = appCbk->event_handler(context, &event);
+            }
+            else
+            {
+                /* No handler for the response. */
+            }
+        }
+    }
+
+    if (block != NULL)
+    {
+        Cy_HPI_Master_EventRelease(context, &block[CY_HPI_MASTER_EVT_POOL_HDR_SIZE]);
+    }
+
+    if (status > CY_HPI_MASTER_INVALID_ARGS)
+    {
+        Cy_HPI_Master_ReportError(context, slaveDev, status);
+    }
+
+    return handled;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuFail
+****************************************************************************//**
+*
+* Ends the firmware update of a slave device with a failure.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_FwuFail(cy_hpi_master_context_t *context,
+                                  cy_hpi_master_fwu_slave_t *fwuSlave,
+                                  cy_hpi_master_status_t status)
+{
+    fwuSlave->state  = CY_HPI_MASTER_FWU_STATE_FAILED;
+    fwuSlave->status = status;
+    context->ptrFwUpdate->activeCount--;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuXferDone
+****************************************************************************//**
+*
+* Completion callback of the register writes queued by the firmware update.
+* A failed write ends the update of the slave device, whose response would
+* never arrive.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_FwuXferDone(cy_hpi_master_context_t *context,
+                                      cy_hpi_master_status_t status,
+                                      void *tag)
+{
+    cy_hpi_master_fwu_slave_t *fwuSlave = (cy_hpi_master_fwu_slave_t *)tag;
+
+    if ((status != CY_HPI_MASTER_SUCCESS) && (fwuSlave->state < CY_HPI_MASTER_FWU_STATE_DONE))
+    {
+        Cy_HPI_Master_FwuFail(context, fwuSlave, status);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuWrite
+****************************************************************************//**
+*
+* Queues a register write of the firmware update on the bus of the slave
+* device, or performs it with a blocking transfer if the bus has no
+* asynchronous transaction queue.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_FwuWrite(cy_hpi_master_context_t *context,
+                                                     cy_hpi_master_fwu_slave_t *fwuSlave,
+                                                     uint16_t regAddress,
+                                                     const uint8_t *writeBuff,
+                                                     uint16_t writeLen)
+{
+    uint8_t slaveIdx = fwuSlave->slaveIdx;
+    uint8_t slaveAddr = context->ptrSlaves[slaveIdx].slaveAddr;
+    cy_hpi_master_bus_t *bus = Cy_HPI_Master_GetBus(context, slaveIdx);
+
+    if (bus == NULL)
+    {
+        return CY_HPI_MASTER_SLAVE_QUARANTINED;
+    }
+
+    /* The response to the step is expected within the timeout. */
+    fwuSlave->countdown = context->ptrFwUpdate->timeout;
+
+    if (bus->ptrXferQueue == NULL)
+    {
+        return Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveAddr, regAddress, (void *)writeBuff, writeLen);
+    }
+
+    return Cy_HPI_Master_XferEnqueue(context, slaveIdx, slaveAddr, regAddress, (uint8_t *)writeBuff, writeLen,
+                                     true, Cy_HPI_Master_FwuXferDone, fwuSlave);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuNext
+****************************************************************************//**
+*
+* Issues the next step of the firmware update of a slave device: the next
+* row, the stream flush after the last streamed row, or the firmware
+* validation.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_FwuNext(cy_hpi_master_context_t *context, cy_hpi_master_fwu_slave_t *fwuSlave)
+{
+    cy_hpi_master_fw_update_t *fwUpdate = context->ptrFwUpdate;
+    cy_hpi_master_status_t status;
+    uint16_t row;
+
+    if (fwuSlave->rowsDone < fwUpdate->rowCount)
+    {
+        row = fwUpdate->startRow + fwuSlave->rowsDone;
+
+        fwuSlave->cmd[0] = CY_HPI_MASTER_FLASH_READ_WRITE_CMD_SIG;
+        fwuSlave->cmd[1] = fwUpdate->stream ? CY_HPI_MASTER_FLASH_ROW_STREAM_WRITE_CMD :
+                                              CY_HPI_MASTER_FLASH_ROW_WRITE_CMD;
+        fwuSlave->cmd[2] = (uint8_t)row;
+        fwuSlave->cmd[3] = (uint8_t)(row >> 8);
+        fwuSlave->state  = CY_HPI_MASTER_FWU_STATE_ROW;
+
+        status = Cy_HPI_Master_FwuWrite(context, fwuSlave, CY_HPI_MASTER_FLASH_MEM_ADDR,
+                                        &fwUpdate->ptrImage[(uint32_t)fwuSlave->rowsDone * fwUpdate->rowSize],
+                                        fwUpdate->rowSize);
+        if (status == CY_HPI_MASTER_SUCCESS)
+        {
+            status = Cy_HPI_Master_FwuWrite(context, fwuSlave, (uint16_t)CY_HPI_MASTER_DEV_REG_FLASH_READ_WRITE,
+                                            fwuSlave->cmd, 4U);
+        }
+    }
+    else if ((fwUpdate->stream) && (fwuSlave->state == CY_HPI_MASTER_FWU_STATE_ROW))
+    {
+        fwuSlave->cmd[0] = CY_HPI_MASTER_FLASH_READ_WRITE_CMD_SIG;
+        fwuSlave->cmd[1] = CY_HPI_MASTER_FLASH_STREAM_FLUSH_CMD;
+        fwuSlave->cmd[2] = 0U;
+        fwuSlave->cmd[3] = 0U;
+        fwuSlave->state  = CY_HPI_MASTER_FWU_STATE_FLUSH;
+
+        status = Cy_HPI_Master_FwuWrite(context, fwuSlave, (uint16_t)CY_HPI_MASTER_DEV_REG_FLASH_READ_WRITE,
+                                        fwuSlave->cmd, 4U);
+    }
+    else
+    {
+        fwuSlave->cmd[0] = fwUpdate->fwMode;
+        fwuSlave->state  = CY_HPI_MASTER_FWU_STATE_VALIDATE;
+
+        status = Cy_HPI_Master_FwuWrite(context, fwuSlave, (uint16_t)CY_HPI_MASTER_DEV_REG_VALIDATE_FW_ADDR,
+                                        fwuSlave->cmd, 1U);
+    }
+
+    if (status != CY_HPI_MASTER_SUCCESS)
+    {
+        Cy_HPI_Master_FwuFail(context, fwuSlave, status);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuResponse
+****************************************************************************//**
+*
+* Handles a device response of a slave device whose firmware is being
+* updated. If the update continues, the slave device is returned through
+* ptrFwuNext; the caller issues the next step once the response interrupt is
+* cleared, so that the clear cannot wipe out the response to the next step.
+* Returns false if the slave device is not being updated, so that the response
+* is passed to the event handler.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_FwuResponse(cy_hpi_master_context_t *context,
+                                      uint8_t slaveIdx,
+                                      uint8_t code,
+                                      cy_hpi_master_fwu_slave_t **ptrFwuNext)
+{
+    cy_hpi_master_fw_update_t *fwUpdate = context->ptrFwUpdate;
+    cy_hpi_master_fwu_slave_t *fwuSlave = NULL;
+    uint8_t idx;
+
+    /* Events have bit 7 of the code set; they are not update responses. */
+    if ((fwUpdate == NULL) || ((code & 0x80U) != 0U))
+    {
+        return false;
+    }
+
+    for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+    {
+        if (fwUpdate->ptrSlaves[idx].slaveIdx == slaveIdx)
+        {
+            fwuSlave = &fwUpdate->ptrSlaves[idx];
+            break;
+        }
+    }
+
+    if ((fwuSlave == NULL) || (fwuSlave->state >= CY_HPI_MASTER_FWU_STATE_DONE))
+    {
+        return false;
+    }
+
+    fwuSlave->response = code;
+
+    if (code != (uint8_t)CY_HPI_MASTER_RESPONSE_SUCCESS)
+    {
+        Cy_HPI_Master_FwuFail(context, fwuSlave, CY_HPI_MASTER_FAILURE);
+    }
+    else if (fwuSlave->state == CY_HPI_MASTER_FWU_STATE_VALIDATE)
+    {
+        fwuSlave->state = CY_HPI_MASTER_FWU_STATE_DONE;
+        fwUpdate->activeCount--;
+    }
+    else
+    {
+        if (fwuSlave->state == CY_HPI_MASTER_FWU_STATE_ROW)
+        {
+            fwuSlave->rowsDone++;
+        }
+        *ptrFwuNext = fwuSlave;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwuCheckTimeout
+****************************************************************************//**
+*
+* Ends the firmware update of the slave devices whose response timeout
+* expired.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_FwuCheckTimeout(cy_hpi_master_context_t *context)
+{
+    cy_hpi_master_fw_update_t *fwUpdate = context->ptrFwUpdate;
+    cy_hpi_master_fwu_slave_t *fwuSlave;
+    uint8_t idx;
+
+    if ((fwUpdate == NULL) || (fwUpdate->timeout == 0U))
+    {
+        return;
+    }
+
+    for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+    {
+        fwuSlave = &fwUpdate->ptrSlaves[idx];
+        if ((fwuSlave->state < CY_HPI_MASTER_FWU_STATE_DONE) && (fwuSlave->countdown == 0U))
+        {
+            Cy_HPI_Master_FwuFail(context, fwuSlave, CY_HPI_MASTER_TIMEOUT);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PdResponseSg
+****************************************************************************//**
+*
+* Reads or writes a list of PD response register segments, merging the runs
+* of adjacent or overlapping segments into one transfer through the scratch
+* buffer. The register region starts at the given base offset.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_PdResponseSg(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveIdx,
+                                                         uint8_t slaveAddr,
+                                                         uint8_t port,
+                                                         const cy_hpi_master_pd_seg_t *segs,
+                                                         uint8_t segCount,
+                                                         uint8_t *scratch,
+                                                         uint16_t scratchLen,
+                                                         uint16_t baseOffset,
+                                                         bool isWrite)
+{
+    cy_hpi_master_status_t status;
+    uint16_t regAddress;
+    uint32_t start;
+    uint32_t end;
+    uint32_t segEnd;
+    uint8_t idx;
+    uint8_t last;
+    uint8_t seg;
+
+    if ((segs == NULL) || (segCount == 0U))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    for (idx = 0U; idx < segCount; idx++)
+    {
+        if ((segs[idx].buffer == NULL) || (segs[idx].length == 0U))
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+    }
+
+    idx = 0U;
+    while (idx < segCount)
+    {
+        start = segs[idx].offset;
+        end   = start + segs[idx].length;
+        last  = idx + 1U;
+
+        /* Extend the run while the next segment starts within it and the
+         * run still fits in the scratch buffer. */
+        if (scratch != NULL)
+        {
+            while ((last < segCount) && (segs[last].offset >= start) && (segs[last].offset <= end))
+            {
+                segEnd = (uint32_t)segs[last].offset + segs[last].length;
+                if (segEnd < end)
+                {
+                    segEnd = end;
+                }
+                if ((segEnd - start) > scratchLen)
+                {
+                    break;
+                }
+                end = segEnd;
+                last++;
+            }
+        }
+
+        regAddress = (uint16_t)(((uint16_t)port + 1U) << 12) | (uint16_t)((start + baseOffset) & 0x0FFFU);
+
+        if (last == (idx + 1U))
+        {
+            status = isWrite ?
+                Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveAddr, regAddress, segs[idx].buffer,
+                                            segs[idx].length) :
+                Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr, regAddress, segs[idx].buffer,
+                                           segs[idx].length);
+        }
+        else if (isWrite)
+        {
+            for (seg = idx; seg < last; seg++)
+            {
+                (void)memcpy(&scratch[segs[seg].offset - start], segs[seg].buffer, segs[seg].length);
+            }
+            status = Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveAddr, regAddress, scratch,
+                                                 (uint16_t)(end - start));
+        }
+        else
+        {
+            status = Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr, regAddress, scratch,
+                                                (uint16_t)(end - start));
+            for (seg = idx; (status == CY_HPI_MASTER_SUCCESS) && (seg < last); seg++)
+            {
+                (void)memcpy(segs[seg].buffer, &scratch[segs[seg].offset - start], segs[seg].length);
+            }
+        }
+
+        if (status != CY_HPI_MASTER_SUCCESS)
+        {
+            return status;
+        }
+
+        idx = last;
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ServiceSlave
+****************************************************************************//**
+*
+* Reads and handles the interrupt status of a slave device, and clears the
+* handled interrupts.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ServiceSlave(cy_hpi_master_context_t *context, uint8_t slaveIdx)
+{
+    cy_hpi_master_slave_dev_t *slaveDev = &context->ptrSlaves[slaveIdx];
+    cy_hpi_master_app_cbk_t *appCbk = context->ptrAppCbk;
+    cy_hpi_master_status_t status;
+    cy_hpi_master_event_t event;
+    cy_hpi_master_fwu_slave_t *fwuNext = NULL;
+    uint8_t intrStat = 0U;
+    uint8_t resp[2] = {0U};
+    bool handled = false;
+    bool faultSeen = false;
+    bool quarantined;
+    uint32_t intrState;
+
+    /* A quarantined slave device is not accessed until its backoff time
+     * expires. The check and the clear are atomic so that a probe marked by
+     * Cy_HPI_Master_PollTimerHandler is not lost. */
+    intrState   = Cy_SysLib_EnterCriticalSection();
+    quarantined = (slaveDev->health == CY_HPI_MASTER_HEALTH_QUARANTINED);
+    if (quarantined)
+    {
+        Cy_HPI_Master_ClearPending(context, slaveIdx);
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (quarantined)
+    {
+        return;
+    }
+
+    if (slaveDev->health == CY_HPI_MASTER_HEALTH_PROBING)
+    {
+        Cy_HPI_Master_ReportError(context, slaveDev, CY_HPI_MASTER_SLAVE_PROBING);
+    }
+
+    slaveDev->intrReg = 0U;
+
+    status = Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveDev->slaveAddr,
+                                        (uint16_t)CY_HPI_MASTER_DEV_REG_INTR_ADDR, &intrStat, 1U);
+    if (status == CY_HPI_MASTER_SUCCESS)
+    {
+        slaveDev->failCount = 0U;
+
+        if (slaveDev->health == CY_HPI_MASTER_HEALTH_PROBING)
+        {
+            slaveDev->health = CY_HPI_MASTER_HEALTH_OK;
+            context->unhealthyCount--;
+            Cy_HPI_Master_ReportError(context, slaveDev, CY_HPI_MASTER_SLAVE_RECOVERED);
+
+            if (intrStat == 0U)
+            {
+                /* The probe found nothing to service. */
+                Cy_HPI_Master_ClearPending(context, slaveIdx);
+            }
+        }
+
+        if ((intrStat & CY_HPI_MASTER_INTR_REG_CLEAR_DEV_INT) != 0U)
+        {
+            status = Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveDev->slaveAddr,
+                                                (uint16_t)CY_HPI_MASTER_DEV_REG_RESPONSE, resp, 2U);
+            if ((status == CY_HPI_MASTER_SUCCESS) && (resp[0] == (uint8_t)CY_HPI_MASTER_EVENT_RESET_COMPLETE))
+            {
+                Cy_HPI_Master_InvalidatePortCache(context, slaveIdx, CY_HPI_MASTER_PORT_ALL,
+                                                  CY_HPI_MASTER_CACHE_ALL);
+            }
+
+            if ((status == CY_HPI_MASTER_SUCCESS) &&
+                (Cy_HPI_Master_FwuResponse(context, slaveIdx, resp[0], &fwuNext)))
+            {
+                handled = true;
+                slaveDev->intrReg |= CY_HPI_MASTER_INTR_REG_CLEAR_DEV_INT;
+            }
+            else if ((status == CY_HPI_MASTER_SUCCESS) && (appCbk->event_handler != NULL))
+            {
+                event.slaveDev  = slaveDev;
+                event.port      = CY_HPI_MASTER_DEV_PORT;
+                event.eventCode = resp[0];
+                event.eventData = NULL;
+                event.dataLen   = 0U;
+
+                if (context->ptrTrace != NULL)
+                {
+                    Cy_HPI_Master_TraceEvent(context, slaveIdx, CY_HPI_MASTER_DEV_PORT, resp[0], 0U,
+                                             slaveDev->intrTimestamp);
+                }
+
+                if (appCbk->event_handler(context, &event))
+                {
+                    handled = true;
+                    slaveDev->intrReg |= CY_HPI_MASTER_INTR_REG_CLEAR_DEV_INT;
+                }
+            }
+        }
+
+        if ((intrStat & CY_HPI_MASTER_INTR_REG_CLEAR_PORT0_INT) != 0U)
+        {
+            if (Cy_HPI_Master_HandlePortInterrupt(context, slaveIdx, CY_HPI_MASTER_PORT_NUMBER_0, &faultSeen))
+            {
+                handled = true;
+                slaveDev->intrReg |= CY_HPI_MASTER_INTR_REG_CLEAR_PORT0_INT;
+            }
+        }
+
+        if ((intrStat & CY_HPI_MASTER_INTR_REG_CLEAR_PORT1_INT) != 0U)
+        {
+            if (Cy_HPI_Master_HandlePortInterrupt(context, slaveIdx, CY_HPI_MASTER_PORT_NUMBER_1, &faultSeen))
+            {
+                handled = true;
+                slaveDev->intrReg |= CY_HPI_MASTER_INTR_REG_CLEAR_PORT1_INT;
+            }
+        }
+
+        if (slaveDev->intrGpioPort == CY_HPI_MASTER_INTR_GPIO_NONE)
+        {
+            if (intrStat == 0U)
+            {
+                /* Nothing to service until the next poll. */
+                Cy_HPI_Master_ClearPending(context, slaveIdx);
+            }
+            Cy_HPI_Master_UpdatePollInterval(context, slaveDev, (intrStat != 0U));
+        }
+
+        /* A slave device stays in the priority class as long as each of its
+         * interrupts reports a fault. A slave device quarantined by a failed
+         * access above stays out of it. */
+        if (((context->schedFlags & CY_HPI_MASTER_SCHED_FAULT_PRIORITY) != 0U) &&
+            (slaveDev->health != CY_HPI_MASTER_HEALTH_QUARANTINED))
+        {
+            Cy_HPI_Master_SetPriority(context, slaveIdx, faultSeen);
+        }
+    }
+
+    if (status > CY_HPI_MASTER_INVALID_ARGS)
+    {
+        Cy_HPI_Master_ReportError(context, slaveDev, status);
+    }
+
+    if (handled)
+    {
+        /* A slave device with an interrupt source which could not be handled
+         * stays pending, so that the source is serviced again. */
+        if ((intrStat & (uint8_t)(~slaveDev->intrReg) &
+             (CY_HPI_MASTER_INTR_REG_CLEAR_DEV_INT | CY_HPI_MASTER_INTR_REG_CLEAR_PORT0_INT |
+              CY_HPI_MASTER_INTR_REG_CLEAR_PORT1_INT)) == 0U)
+        {
+            Cy_HPI_Master_ClearPending(context, slaveIdx);
+        }
+        status = Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveDev->slaveAddr,
+                                             (uint16_t)CY_HPI_MASTER_DEV_REG_INTR_ADDR, &slaveDev->intrReg, 1U);
+
+        /* The next update step is issued only once its predecessor's response
+         * is cleared. A response which could not be cleared would be handled
+         * again, so the update of the slave device ends instead. */
+        if (fwuNext != NULL)
+        {
+            if (status == CY_HPI_MASTER_SUCCESS)
+            {
+                Cy_HPI_Master_FwuNext(context, fwuNext);
+            }
+            else
+            {
+                Cy_HPI_Master_FwuFail(context, fwuNext, status);
+            }
+        }
+    }
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_Init(cy_hpi_master_context_t *context,
+                                          cy_hpi_master_app_cbk_t *appCbk)
+{
+    cy_hpi_master_event_queue_t *queue;
+    cy_hpi_master_bus_t *bus;
+    cy_hpi_master_evt_pool_t *pool;
+    uint32_t idx;
+
+    if ((context == NULL) || (appCbk == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    queue = context->ptrEventQueue;
+
+    if ((queue == NULL) || (context->ptrSlaves == NULL) || (context->ptrRespBuff == NULL) ||
+        (context->respBuffLen == 0U) ||
+        ((appCbk->i2c_master_read == NULL) && (appCbk->i2c_master_write_read == NULL)) ||
+        (appCbk->i2c_master_write == NULL) || (appCbk->event_handler == NULL) ||
+        (appCbk->error_handler == NULL) || (queue->startAddress == NULL) ||
+        (queue->bufferSize == 0U) || (queue->overflowPolicy > CY_HPI_MASTER_QUEUE_COALESCE) ||
+        ((context->ptrXferQueue != NULL) && (context->xferQueueSize == 0U)))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if ((context->ptrBuses == NULL) || (context->ptrBuses == &context->defaultBus))
+    {
+        context->defaultBus.ptrScbBase    = context->ptrScbBase;
+        context->defaultBus.ptrI2cContext = context->ptrI2cContext;
+        context->defaultBus.ptrXferQueue  = context->ptrXferQueue;
+        context->defaultBus.xferQueueSize = context->xferQueueSize;
+        context->ptrBuses = &context->defaultBus;
+        context->busCount = 1U;
+    }
+
+    if (context->busCount == 0U)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    for (idx = 0U; idx < context->busCount; idx++)
+    {
+        bus = &context->ptrBuses[idx];
+        if ((bus->ptrScbBase == NULL) || (bus->ptrI2cContext == NULL) ||
+            ((bus->ptrXferQueue != NULL) && (bus->xferQueueSize == 0U)))
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+
+        bus->xferCount = 0U;
+        bus->xferHead  = 0U;
+        bus->xferDone  = 0U;
+        bus->xferTail  = 0U;
+        bus->xferBusy  = false;
+        bus->xferHold  = false;
+    }
+
+    for (idx = 0U; idx < Cy_HPI_Master_PoolCount(context); idx++)
+    {
+        pool = &context->ptrEvtPool[idx];
+        if ((pool->startAddress == NULL) || (pool->blockCount == 0U) ||
+            (pool->blockCount > CY_HPI_MASTER_EVT_POOL_MAX_BLOCKS) ||
+            (pool->blockSize <= CY_HPI_MASTER_EVT_POOL_HDR_SIZE) ||
+            ((idx != 0U) && (pool->blockSize < context->ptrEvtPool[idx - 1U].blockSize)))
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+    }
+
+    if ((context->ptrTrace != NULL) &&
+        ((context->ptrTrace->ptrStats == NULL) || (appCbk->get_timestamp == NULL) ||
+         ((context->ptrTrace->ptrRing != NULL) && (context->ptrTrace->ringSize == 0U))))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if ((context->ptrIntrMask == NULL) || (context->ptrPrioMask == NULL))
+    {
+        if (context->maxSlaveDevices > 32U)
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+        if (context->ptrIntrMask == NULL)
+        {
+            context->ptrIntrMask = &context->intrMaskWord;
+        }
+        if (context->ptrPrioMask == NULL)
+        {
+            context->ptrPrioMask = &context->prioMaskWord;
+        }
+    }
+
+    if (context->pollIntervalMin == 0U)
+    {
+        context->pollIntervalMin = CY_HPI_MASTER_POLL_INTERVAL_MIN_DEFAULT;
+    }
+    if (context->pollIntervalMax < context->pollIntervalMin)
+    {
+        context->pollIntervalMax = (context->pollIntervalMin > CY_HPI_MASTER_POLL_INTERVAL_MAX_DEFAULT) ?
+                                   context->pollIntervalMin : CY_HPI_MASTER_POLL_INTERVAL_MAX_DEFAULT;
+    }
+
+    if (context->failThreshold == 0U)
+    {
+        context->failThreshold = CY_HPI_MASTER_FAIL_THRESHOLD_DEFAULT;
+    }
+    if (context->backoffMin == 0U)
+    {
+        context->backoffMin = CY_HPI_MASTER_BACKOFF_MIN_DEFAULT;
+    }
+    if (context->backoffMax < context->backoffMin)
+    {
+        context->backoffMax = (context->backoffMin > CY_HPI_MASTER_BACKOFF_MAX_DEFAULT) ?
+                              context->backoffMin : CY_HPI_MASTER_BACKOFF_MAX_DEFAULT;
+    }
+
+    context->ptrAppCbk   = appCbk;
+    context->intrSummary = 0U;
+    context->slaveCount  = 0U;
+    context->rrNextIdx   = 0U;
+    context->unhealthyCount = 0U;
+    context->ptrFwUpdate = NULL;
+    (void)memset(context->ptrIntrMask, 0,
+                 CY_HPI_MASTER_INTR_MASK_WORDS(context->maxSlaveDevices) * sizeof(uint32_t));
+    (void)memset(context->ptrPrioMask, 0,
+                 CY_HPI_MASTER_INTR_MASK_WORDS(context->maxSlaveDevices) * sizeof(uint32_t));
+
+    for (idx = 0U; idx < Cy_HPI_Master_PoolCount(context); idx++)
+    {
+        pool = &context->ptrEvtPool[idx];
+        pool->freeMask = (pool->blockCount == CY_HPI_MASTER_EVT_POOL_MAX_BLOCKS) ?
+                         0xFFFFFFFFU : ((1UL << pool->blockCount) - 1UL);
+        pool->allocFailCount = 0U;
+    }
+
+    if (context->ptrTrace != NULL)
+    {
+        (void)memset(context->ptrTrace->ptrStats, 0,
+                     CY_HPI_MASTER_TRACE_STATS_ENTRIES(context->maxSlaveDevices) * sizeof(cy_hpi_master_trace_stats_t));
+        context->ptrTrace->ringIdx   = 0U;
+        context->ptrTrace->ringCount = 0U;
+    }
+
+    if (context->ptrPortCache != NULL)
+    {
+        (void)memset(context->ptrPortCache, 0,
+                     CY_HPI_MASTER_CACHE_ENTRIES(context->maxSlaveDevices) * sizeof(cy_hpi_master_port_cache_t));
+    }
+
+    for (idx = 0U; idx < context->maxSlaveDevices; idx++)
+    {
+        context->ptrSlaves[idx].slaveAddr    = CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+        context->ptrSlaves[idx].intrGpioPort = CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+        context->ptrSlaves[idx].intrGpioPin  = CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+        context->ptrSlaves[idx].portCount    = 0U;
+        context->ptrSlaves[idx].intrReg      = 0U;
+        context->ptrSlaves[idx].failCount    = 0U;
+        context->ptrSlaves[idx].pollInterval  = 0U;
+        context->ptrSlaves[idx].pollCountdown = 0U;
+        context->ptrSlaves[idx].busIdx        = 0U;
+        context->ptrSlaves[idx].health           = CY_HPI_MASTER_HEALTH_OK;
+        context->ptrSlaves[idx].backoff          = 0U;
+        context->ptrSlaves[idx].backoffCountdown = 0U;
+    }
+
+    queue->headIdx     = 0U;
+    queue->tailIdx     = 0U;
+    queue->dispatching = false;
+    (void)memset(&queue->stats, 0, sizeof(queue->stats));
+    (void)memset(queue->startAddress, 0, queue->bufferSize);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_DeInit(cy_hpi_master_context_t *context)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    (void)memset(context->ptrEventQueue, 0, sizeof(cy_hpi_master_event_queue_t));
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_SlaveDeviceInit(cy_hpi_master_context_t *context,
+                                                  uint8_t slaveAddr,
+                                                  uint8_t intrGpioPort,
+                                                  uint8_t intrGpioPin,
+                                                  uint8_t portCount)
+{
+    return Cy_HPI_Master_SlaveDeviceBusInit(context, slaveAddr, intrGpioPort, intrGpioPin, portCount, 0U);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_SlaveDeviceBusInit(cy_hpi_master_context_t *context,
+                                                     uint8_t slaveAddr,
+                                                     uint8_t intrGpioPort,
+                                                     uint8_t intrGpioPin,
+                                                     uint8_t portCount,
+                                                     uint8_t busIdx)
+{
+    cy_hpi_master_slave_dev_t *slaveDev;
+
+    if ((context == NULL) || (busIdx >= context->busCount))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if ((context->ptrSlaves == NULL) || (context->slaveCount >= context->maxSlaveDevices))
+    {
+        return CY_HPI_MASTER_FAILURE;
+    }
+
+    slaveDev = &context->ptrSlaves[context->slaveCount];
+    slaveDev->slaveAddr    = slaveAddr;
+    slaveDev->intrGpioPort = intrGpioPort;
+    slaveDev->intrGpioPin  = intrGpioPin;
+    slaveDev->portCount    = portCount;
+    slaveDev->intrReg      = 0U;
+    slaveDev->failCount    = 0U;
+    slaveDev->busIdx       = busIdx;
+    slaveDev->health       = CY_HPI_MASTER_HEALTH_OK;
+    slaveDev->backoff      = 0U;
+    slaveDev->backoffCountdown = 0U;
+
+    /* Slave devices without an interrupt GPIO are polled, starting at the
+     * shortest interval. */
+    slaveDev->pollInterval  = context->pollIntervalMin;
+    slaveDev->pollCountdown = (intrGpioPort == CY_HPI_MASTER_INTR_GPIO_NONE) ? context->pollIntervalMin : 0U;
+
+    context->slaveCount++;
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_DiscoverSlaves(cy_hpi_master_context_t *context,
+                                                    uint8_t busIdx,
+                                                    const uint8_t *addrList,
+                                                    uint8_t addrCount,
+                                                    cy_hpi_master_dev_info_t *devInfo,
+                                                    uint8_t maxDevices,
+                                                    uint8_t *devCount)
+{
+    static const uint8_t defaultAddr[CY_HPI_MASTER_DISCOVER_ADDR_COUNT] =
+    {
+        CY_HPI_MASTER_ADDR_I2C_CFG_LOW,
+        CY_HPI_MASTER_ADDR_I2C_CFG_HIGH,
+        CY_HPI_MASTER_ADDR_I2C_CFG_FLOAT
+    };
+    cy_hpi_master_dev_info_t localInfo;
+    cy_hpi_master_dev_info_t *info;
+    cy_hpi_master_bus_t *bus;
+    cy_hpi_master_status_t status = CY_HPI_MASTER_SUCCESS;
+    uint8_t devRegs[4];
+    uint8_t portCount;
+    uint8_t found = 0U;
+    uint8_t idx;
+
+    if ((context == NULL) || (devCount == NULL) || (context->ptrAppCbk == NULL) ||
+        ((context->ptrAppCbk->i2c_master_read == NULL) && (context->ptrAppCbk->i2c_master_write_read == NULL)) ||
+        (busIdx >= context->busCount))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if (addrList == NULL)
+    {
+        addrList  = defaultAddr;
+        addrCount = CY_HPI_MASTER_DISCOVER_ADDR_COUNT;
+    }
+
+    bus = &context->ptrBuses[busIdx];
+
+    for (idx = 0U; (idx < addrCount) && (found < maxDevices); idx++)
+    {
+        if (Cy_HPI_Master_GetSlaveIndexByAddr(context, addrList[idx]) != CY_HPI_MASTER_UNKNOWN_SLAVE_IDX)
+        {
+            continue;
+        }
+
+        /* Device Mode, Boot Mode Reason and Silicon ID in one transfer. */
+        if (Cy_HPI_Master_BusRead(context, bus, CY_HPI_MASTER_UNKNOWN_SLAVE_IDX, addrList[idx],
+                                  (uint16_t)CY_HPI_MASTER_DEV_REG_DEVICE_MODE, devRegs,
+                                  (uint16_t)sizeof(devRegs)) != CY_HPI_MASTER_SUCCESS)
+        {
+            continue;
+        }
+
+        info = (devInfo != NULL) ? &devInfo[found] : &localInfo;
+        (void)memset(info, 0, sizeof(cy_hpi_master_dev_info_t));
+
+        portCount = (uint8_t)(((devRegs[0] & CY_HPI_MASTER_DEV_MODE_PORT_MASK) >> CY_HPI_MASTER_DEV_MODE_PORT_POS) + 1U);
+        if (portCount > CY_HPI_MASTER_CACHE_PORT_COUNT)
+        {
+            portCount = CY_HPI_MASTER_CACHE_PORT_COUNT;
+        }
+
+        info->slaveAddr  = addrList[idx];
+        info->deviceMode = devRegs[0];
+        info->portCount  = portCount;
+        info->siliconId  = (uint16_t)(((uint16_t)devRegs[2] << 8) | devRegs[3]);
+
+        /* A device which stops responding is not registered. */
+        if (Cy_HPI_Master_BusRead(context, bus, CY_HPI_MASTER_UNKNOWN_SLAVE_IDX, addrList[idx],
+                                  (uint16_t)CY_HPI_MASTER_DEV_REG_ALL_VERSION_BYTE, info->allVersion,
+                                  CY_HPI_MASTER_DEV_REG_ALL_VERSION_BYTES) != CY_HPI_MASTER_SUCCESS)
+        {
+            continue;
+        }
+
+        info->slaveIdx = context->slaveCount;
+        if (Cy_HPI_Master_SlaveDeviceBusInit(context, addrList[idx], CY_HPI_MASTER_INTR_GPIO_NONE,
+                                             CY_HPI_MASTER_INTR_GPIO_NONE, portCount, busIdx) != CY_HPI_MASTER_SUCCESS)
+        {
+            status = CY_HPI_MASTER_FAILURE;
+            break;
+        }
+
+        found++;
+    }
+
+    *devCount = found;
+
+    return status;
+}
+
+void Cy_HPI_Master_InterruptHandler(cy_hpi_master_context_t *context,
+                                    uint8_t gpioPort,
+                                    uint8_t gpioPin)
+{
+    uint8_t idx;
+
+    for (idx = 0U; idx < context->slaveCount; idx++)
+    {
+        if ((context->ptrSlaves[idx].intrGpioPort == gpioPort) &&
+            (context->ptrSlaves[idx].intrGpioPin == gpioPin))
+        {
+            Cy_HPI_Master_SetPending(context, idx);
+        }
+    }
+}
+
+void Cy_HPI_Master_PollTimerHandler(cy_hpi_master_context_t *context,
+                                    uint16_t elapsed)
+{
+    cy_hpi_master_fw_update_t *fwUpdate;
+    cy_hpi_master_fwu_slave_t *fwuSlave;
+    cy_hpi_master_slave_dev_t *slaveDev;
+    uint8_t idx;
+
+    for (idx = 0U; idx < context->slaveCount; idx++)
+    {
+        slaveDev = &context->ptrSlaves[idx];
+
+        /* The countdown stays at 0 until the poll is serviced. */
+        if ((slaveDev->intrGpioPort == CY_HPI_MASTER_INTR_GPIO_NONE) && (slaveDev->pollCountdown != 0U))
+        {
+            if (slaveDev->pollCountdown > elapsed)
+            {
+                slaveDev->pollCountdown -= elapsed;
+            }
+            else
+            {
+                slaveDev->pollCountdown = 0U;
+                Cy_HPI_Master_SetPending(context, idx);
+            }
+        }
+
+        /* A quarantined slave device is probed when its backoff time expires. */
+        if ((slaveDev->health == CY_HPI_MASTER_HEALTH_QUARANTINED) && (slaveDev->backoffCountdown != 0U))
+        {
+            if (slaveDev->backoffCountdown > elapsed)
+            {
+                slaveDev->backoffCountdown -= elapsed;
+            }
+            else
+            {
+                slaveDev->backoffCountdown = 0U;
+                slaveDev->health = CY_HPI_MASTER_HEALTH_PROBING;
+                Cy_HPI_Master_SetPending(context, idx);
+            }
+        }
+    }
+
+    /* The expired firmware update steps are failed by Cy_HPI_Master_Task. */
+    fwUpdate = context->ptrFwUpdate;
+    if ((fwUpdate != NULL) && (fwUpdate->timeout != 0U))
+    {
+        for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+        {
+            fwuSlave = &fwUpdate->ptrSlaves[idx];
+            if ((fwuSlave->state < CY_HPI_MASTER_FWU_STATE_DONE) && (fwuSlave->countdown != 0U))
+            {
+                if (fwuSlave->countdown > elapsed)
+                {
+                    fwuSlave->countdown -= elapsed;
+                }
+                else
+                {
+                    fwuSlave->countdown = 0U;
+                }
+            }
+        }
+    }
+}
+
+void Cy_HPI_Master_SlaveInterruptHandler(cy_hpi_master_context_t *context,
+                                         uint8_t slaveIdx)
+{
+    if (slaveIdx < context->slaveCount)
+    {
+        Cy_HPI_Master_SetPending(context, slaveIdx);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ServicePriority
+****************************************************************************//**
+*
+* Services the slave devices in the priority class which have an interrupt
+* pending.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ServicePriority(cy_hpi_master_context_t *context)
+{
+    uint32_t summary = context->intrSummary;
+    uint32_t word;
+    uint32_t bits;
+
+    while (summary != 0U)
+    {
+        word     = Cy_HPI_Master_Ctz(summary);
+        summary &= (summary - 1U);
+        bits     = context->ptrIntrMask[word] & context->ptrPrioMask[word];
+
+        while (bits != 0U)
+        {
+            Cy_HPI_Master_ServiceSlave(context, (uint8_t)((word << 5) + Cy_HPI_Master_Ctz(bits)));
+            bits &= (bits - 1U);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_QueueBacklogged
+****************************************************************************//**
+*
+* Checks whether more than half of the event queue buffer is in use.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_QueueBacklogged(cy_hpi_master_context_t *context)
+{
+    cy_hpi_master_event_queue_t *queue = context->ptrEventQueue;
+    uint32_t headIdx = queue->headIdx;
+    uint32_t tailIdx = queue->tailIdx;
+    uint32_t used;
+
+    used = (tailIdx >= headIdx) ? (tailIdx - headIdx) : ((queue->bufferSize - headIdx) + tailIdx);
+
+    return (used > ((uint32_t)queue->bufferSize >> 1));
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_ServiceRoundRobin
+****************************************************************************//**
+*
+* Services up to slaveBudget pending slave devices, starting with the first
+* one at or after rrNextIdx and wrapping around once. The pass starts only
+* once the events queued by the previous pass are dispatched, and stops if
+* the event queue becomes more than half full, so that the slave devices hold
+* their events until there is room for them.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_ServiceRoundRobin(cy_hpi_master_context_t *context)
+{
+    uint32_t budget = (context->slaveBudget != 0U) ? context->slaveBudget : context->slaveCount;
+    uint32_t startIdx = context->rrNextIdx;
+    bool wrapped = false;
+    uint8_t slaveIdx;
+
+    if (context->ptrEventQueue->headIdx != context->ptrEventQueue->tailIdx)
+    {
+        return;
+    }
+
+    slaveIdx = Cy_HPI_Master_FindNextPending(context, startIdx);
+
+    while ((budget != 0U) && (!Cy_HPI_Master_QueueBacklogged(context)))
+    {
+        if (slaveIdx == CY_HPI_MASTER_UNKNOWN_SLAVE_IDX)
+        {
+            if ((wrapped) || (startIdx == 0U))
+            {
+                break;
+            }
+            wrapped  = true;
+            slaveIdx = Cy_HPI_Master_FindNextPending(context, 0U);
+            continue;
+        }
+
+        if ((wrapped) && (slaveIdx >= startIdx))
+        {
+            break;
+        }
+
+        Cy_HPI_Master_ServiceSlave(context, slaveIdx);
+        context->rrNextIdx = (uint8_t)(((uint32_t)slaveIdx + 1U) % context->slaveCount);
+        budget--;
+
+        slaveIdx = Cy_HPI_Master_FindNextPending(context, (uint32_t)slaveIdx + 1U);
+    }
+}
+
+void Cy_HPI_Master_Task(cy_hpi_master_context_t *context)
+{
+    uint32_t evtCount;
+    uint8_t slaveIdx;
+    uint8_t busIdx;
+
+    for (busIdx = 0U; busIdx < context->busCount; busIdx++)
+    {
+        Cy_HPI_Master_ProcessXfers(context, &context->ptrBuses[busIdx]);
+    }
+
+    Cy_HPI_Master_FwuCheckTimeout(context);
+
+    if ((context->schedFlags & CY_HPI_MASTER_SCHED_FAULT_PRIORITY) != 0U)
+    {
+        Cy_HPI_Master_ServicePriority(context);
+    }
+
+    if ((context->schedFlags & CY_HPI_MASTER_SCHED_ROUND_ROBIN) != 0U)
+    {
+        Cy_HPI_Master_ServiceRoundRobin(context);
+
+        evtCount = (context->evtBudget != 0U) ? context->evtBudget : 1U;
+        while ((evtCount != 0U) && (Cy_HPI_Master_ProcessQueue(context)))
+        {
+            evtCount--;
+        }
+    }
+    else if (context->intrSummary != 0U)
+    {
+        slaveIdx = Cy_HPI_Master_FindNextPending(context, 0U);
+        while (slaveIdx != CY_HPI_MASTER_UNKNOWN_SLAVE_IDX)
+        {
+            Cy_HPI_Master_ServiceSlave(context, slaveIdx);
+            slaveIdx = Cy_HPI_Master_FindNextPending(context, (uint32_t)slaveIdx + 1U);
+        }
+    }
+    else
+    {
+        (void)Cy_HPI_Master_ProcessQueue(context);
+    }
+}
+
+uint8_t Cy_HPI_Master_GetSlaveIndexByAddr(cy_hpi_master_context_t *context,
+                                          uint8_t slaveAddr)
+{
+    uint8_t idx;
+
+    for (idx = 0U; idx < context->slaveCount; idx++)
+    {
+        if (context->ptrSlaves[idx].slaveAddr == slaveAddr)
+        {
+            return idx;
+        }
+    }
+
+    return CY_HPI_MASTER_UNKNOWN_SLAVE_IDX;
+}
+
+uint8_t Cy_HPI_Master_GetSlaveHealth(cy_hpi_master_context_t *context,
+                                     uint8_t slaveIdx)
+{
+    if ((context == NULL) || (slaveIdx >= context->slaveCount))
+    {
+        return CY_HPI_MASTER_HEALTH_QUARANTINED;
+    }
+
+    return context->ptrSlaves[slaveIdx].health;
+}
+
+void Cy_HPI_Master_SlaveProbe(cy_hpi_master_context_t *context,
+                              uint8_t slaveIdx)
+{
+    cy_hpi_master_slave_dev_t *slaveDev;
+    uint32_t intrState;
+
+    if ((context == NULL) || (slaveIdx >= context->slaveCount))
+    {
+        return;
+    }
+
+    slaveDev  = &context->ptrSlaves[slaveIdx];
+    intrState = Cy_SysLib_EnterCriticalSection();
+    if (slaveDev->health == CY_HPI_MASTER_HEALTH_QUARANTINED)
+    {
+        slaveDev->backoffCountdown = 0U;
+        slaveDev->health = CY_HPI_MASTER_HEALTH_PROBING;
+        Cy_HPI_Master_SetPending(context, slaveIdx);
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_RegisterRead (cy_hpi_master_context_t *context,
+                                                  uint8_t slaveAddr,
+                                                  uint16_t regAddress,
+                                                  uint8_t *readBuff,
+                                                  uint16_t readLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_SlaveRegRead(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr,
+                                      regAddress, readBuff, readLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_RegisterWrite(cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 uint16_t regAddress,
+                                                 void *writeBuff,
+                                                 uint16_t writeLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_SlaveRegWrite(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr,
+                                       regAddress, writeBuff, writeLen);
+}
+
+void Cy_HPI_Master_EventRelease(cy_hpi_master_context_t *context, uint8_t *eventData)
+{
+    cy_hpi_master_evt_pool_t *pool;
+    uint32_t intrState;
+    uint32_t offset;
+    uint8_t poolIdx;
+
+    if ((context == NULL) || (eventData == NULL))
+    {
+        return;
+    }
+
+    for (poolIdx = 0U; poolIdx < Cy_HPI_Master_PoolCount(context); poolIdx++)
+    {
+        pool = &context->ptrEvtPool[poolIdx];
+        if ((eventData < &pool->startAddress[CY_HPI_MASTER_EVT_POOL_HDR_SIZE]) ||
+            (eventData >= &pool->startAddress[(uint32_t)pool->blockCount * pool->blockSize]))
+        {
+            continue;
+        }
+
+        offset = (uint32_t)(eventData - pool->startAddress) - CY_HPI_MASTER_EVT_POOL_HDR_SIZE;
+        if ((offset % pool->blockSize) == 0U)
+        {
+            intrState = Cy_SysLib_EnterCriticalSection();
+            pool->freeMask |= (1UL << (offset / pool->blockSize));
+            Cy_SysLib_ExitCriticalSection(intrState);
+        }
+        return;
+    }
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_GetQueueStats(cy_hpi_master_context_t *context,
+                                                   cy_hpi_master_queue_stats_t *stats,
+                                                   bool clear)
+{
+    uint32_t intrState;
+
+    if ((context == NULL) || (context->ptrEventQueue == NULL) || (stats == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *stats = context->ptrEventQueue->stats;
+    if (clear)
+    {
+        (void)memset(&context->ptrEventQueue->stats, 0, sizeof(cy_hpi_master_queue_stats_t));
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_GetTraceStats(cy_hpi_master_context_t *context,
+                                                   uint8_t slaveIdx,
+                                                   uint8_t traceClass,
+                                                   cy_hpi_master_trace_stats_t *stats,
+                                                   bool clear)
+{
+    cy_hpi_master_trace_stats_t *entry;
+    uint32_t intrState;
+
+    if ((context == NULL) || (context->ptrTrace == NULL) || (stats == NULL) ||
+        (slaveIdx >= context->slaveCount) || (traceClass >= CY_HPI_MASTER_TRACE_CLASS_COUNT))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    entry = &context->ptrTrace->ptrStats[((uint32_t)slaveIdx * CY_HPI_MASTER_TRACE_CLASS_COUNT) + traceClass];
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    *stats = *entry;
+    if (clear)
+    {
+        (void)memset(entry, 0, sizeof(cy_hpi_master_trace_stats_t));
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+uint16_t Cy_HPI_Master_GetTraceRecords(cy_hpi_master_context_t *context,
+                                       cy_hpi_master_trace_rec_t *records,
+                                       uint16_t maxCount)
+{
+    cy_hpi_master_trace_t *trace;
+    uint32_t intrState;
+    uint32_t count;
+    uint32_t idx;
+    uint32_t readIdx;
+
+    if ((context == NULL) || (context->ptrTrace == NULL) || (context->ptrTrace->ptrRing == NULL) ||
+        (records == NULL))
+    {
+        return 0U;
+    }
+
+    trace = context->ptrTrace;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+
+    count = (trace->ringCount < trace->ringSize) ? trace->ringCount : trace->ringSize;
+    if (count > maxCount)
+    {
+        count = maxCount;
+    }
+
+    /* Copy the newest records, oldest first. */
+    readIdx = ((uint32_t)trace->ringIdx + trace->ringSize - count) % trace->ringSize;
+    for (idx = 0U; idx < count; idx++)
+    {
+        records[idx] = trace->ptrRing[readIdx];
+        readIdx = (readIdx + 1U) % trace->ringSize;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return (uint16_t)count;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_RegisterReadAsync(cy_hpi_master_context_t *context,
+                                                       uint8_t slaveAddr,
+                                                       uint16_t regAddress,
+                                                       uint8_t *readBuff,
+                                                       uint16_t readLen,
+                                                       cy_hpi_master_xfer_cbk_t cbk,
+                                                       void *tag)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_XferEnqueue(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr,
+                                     regAddress, readBuff, readLen, false, cbk, tag);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_RegisterWriteAsync(cy_hpi_master_context_t *context,
+                                                        uint8_t slaveAddr,
+                                                        uint16_t regAddress,
+                                                        void *writeBuff,
+                                                        uint16_t writeLen,
+                                                        cy_hpi_master_xfer_cbk_t cbk,
+                                                        void *tag)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_XferEnqueue(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr,
+                                     regAddress, (uint8_t *)writeBuff, writeLen, true, cbk, tag);
+}
+
+void Cy_HPI_Master_XferComplete(cy_hpi_master_context_t *context, bool success)
+{
+    Cy_HPI_Master_BusXferComplete(context, 0U, success);
+}
+
+void Cy_HPI_Master_BusXferComplete(cy_hpi_master_context_t *context, uint8_t busIdx, bool success)
+{
+    cy_hpi_master_bus_t *bus;
+    uint32_t intrState;
+
+    if ((context == NULL) || (busIdx >= context->busCount))
+    {
+        return;
+    }
+
+    bus = &context->ptrBuses[busIdx];
+    if ((bus->ptrXferQueue == NULL) || (!bus->xferBusy))
+    {
+        return;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    bus->ptrXferQueue[((uint32_t)bus->xferHead + bus->xferDone) % bus->xferQueueSize].status =
+        success ? CY_HPI_MASTER_SUCCESS : CY_HPI_MASTER_I2C_FAILURE;
+    bus->xferDone++;
+    bus->xferBusy = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    Cy_HPI_Master_XferStart(context, bus);
+}
+
+bool Cy_HPI_Master_XferIdle(cy_hpi_master_context_t *context)
+{
+    uint8_t busIdx;
+
+    if (context == NULL)
+    {
+        return true;
+    }
+
+    for (busIdx = 0U; busIdx < context->busCount; busIdx++)
+    {
+        if (context->ptrBuses[busIdx].xferCount != 0U)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_GroupWrite(cy_hpi_master_context_t *context,
+                                                const uint8_t *slaveIdxList,
+                                                uint8_t listLen,
+                                                uint16_t regAddress,
+                                                void *writeBuff,
+                                                uint16_t writeLen,
+                                                cy_hpi_master_status_t *slaveStatus)
+{
+    cy_hpi_master_status_t result = CY_HPI_MASTER_SUCCESS;
+    cy_hpi_master_status_t status;
+    cy_hpi_master_slave_dev_t *slaveDev;
+    cy_hpi_master_bus_t *bus;
+    uint32_t pending;
+    uint32_t remaining;
+    uint32_t waitUs;
+    uint8_t count;
+    uint8_t idx;
+    uint8_t busIdx;
+    uint8_t slaveIdx;
+
+    if ((context == NULL) || (writeBuff == NULL) || (slaveStatus == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    count = (slaveIdxList != NULL) ? listLen : context->slaveCount;
+    for (idx = 0U; idx < count; idx++)
+    {
+        if ((slaveIdxList != NULL) && (slaveIdxList[idx] >= context->slaveCount))
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+    }
+
+    /* Queue the writes back to back. The transfers of the slave devices on
+     * different buses run at the same time. */
+    for (idx = 0U; idx < count; idx++)
+    {
+        slaveIdx = (slaveIdxList != NULL) ? slaveIdxList[idx] : idx;
+        slaveDev = &context->ptrSlaves[slaveIdx];
+        slaveStatus[idx] = CY_HPI_MASTER_FAILURE;
+
+        if ((regAddress >> 12) != 0U)
+        {
+            Cy_HPI_Master_InvalidatePortCache(context, slaveIdx, (uint8_t)((regAddress >> 12) - 1U),
+                                              CY_HPI_MASTER_CACHE_ALL);
+        }
+
+        bus = Cy_HPI_Master_GetBus(context, slaveIdx);
+        if (bus == NULL)
+        {
+            slaveStatus[idx] = CY_HPI_MASTER_SLAVE_QUARANTINED;
+        }
+        else if (bus->ptrXferQueue == NULL)
+        {
+            slaveStatus[idx] = Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveDev->slaveAddr, regAddress,
+                                                           writeBuff, writeLen);
+        }
+        else
+        {
+            /* CY_HPI_MASTER_TIMEOUT marks the write as queued until its
+             * completion callback stores the result. */
+            slaveStatus[idx] = CY_HPI_MASTER_TIMEOUT;
+
+            waitUs = 0U;
+            status = Cy_HPI_Master_XferEnqueue(context, slaveIdx, slaveDev->slaveAddr, regAddress,
+                                               (uint8_t *)writeBuff, writeLen, true, Cy_HPI_Master_GroupWriteDone,
+                                               &slaveStatus[idx]);
+            while ((status == CY_HPI_MASTER_QUEUE_OVERFLOW) && (waitUs < CY_HPI_MASTER_XFER_TIMEOUT_US))
+            {
+                Cy_HPI_Master_ProcessXfers(context, bus);
+                status = Cy_HPI_Master_XferEnqueue(context, slaveIdx, slaveDev->slaveAddr, regAddress,
+                                                   (uint8_t *)writeBuff, writeLen, true,
+                                                   Cy_HPI_Master_GroupWriteDone, &slaveStatus[idx]);
+                if (status == CY_HPI_MASTER_QUEUE_OVERFLOW)
+                {
+                    Cy_SysLib_DelayUs((uint16_t)CY_HPI_MASTER_XFER_POLL_US);
+                    waitUs += CY_HPI_MASTER_XFER_POLL_US;
+                }
+            }
+            if (status == CY_HPI_MASTER_QUEUE_OVERFLOW)
+            {
+                status = CY_HPI_MASTER_TIMEOUT;
+            }
+            if (status != CY_HPI_MASTER_SUCCESS)
+            {
+                slaveStatus[idx] = status;
+            }
+        }
+    }
+
+    /* Collect the completions of the writes queued above. The wait gives up
+     * if none of them completes for CY_HPI_MASTER_XFER_TIMEOUT_US. */
+    waitUs  = 0U;
+    pending = Cy_HPI_Master_GroupWritePending(slaveStatus, count);
+    while ((pending != 0U) && (waitUs < CY_HPI_MASTER_XFER_TIMEOUT_US))
+    {
+        for (busIdx = 0U; busIdx < context->busCount; busIdx++)
+        {
+            Cy_HPI_Master_ProcessXfers(context, &context->ptrBuses[busIdx]);
+        }
+
+        remaining = Cy_HPI_Master_GroupWritePending(slaveStatus, count);
+        if (remaining < pending)
+        {
+            pending = remaining;
+            waitUs  = 0U;
+        }
+        else
+        {
+            Cy_SysLib_DelayUs((uint16_t)CY_HPI_MASTER_XFER_POLL_US);
+            waitUs += CY_HPI_MASTER_XFER_POLL_US;
+        }
+    }
+
+    if (pending != 0U)
+    {
+        Cy_HPI_Master_GroupWriteDetach(context, slaveStatus, count);
+    }
+
+    for (idx = 0U; idx < count; idx++)
+    {
+        if (slaveStatus[idx] != CY_HPI_MASTER_SUCCESS)
+        {
+            result = CY_HPI_MASTER_FAILURE;
+        }
+    }
+
+    return result;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_FwUpdateStart(cy_hpi_master_context_t *context,
+                                                   cy_hpi_master_fw_update_t *fwUpdate)
+{
+    cy_hpi_master_fwu_slave_t *fwuSlave;
+    cy_hpi_master_status_t status;
+    uint8_t idx;
+
+    if ((context == NULL) || (fwUpdate == NULL) || (fwUpdate->ptrImage == NULL) || (fwUpdate->rowSize == 0U) ||
+        (fwUpdate->rowCount == 0U) || (fwUpdate->ptrSlaves == NULL) || (fwUpdate->slaveCount == 0U))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    if (context->ptrFwUpdate != NULL)
+    {
+        /* Only one update runs at a time. */
+        return CY_HPI_MASTER_FAILURE;
+    }
+
+    for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+    {
+        if (fwUpdate->ptrSlaves[idx].slaveIdx >= context->slaveCount)
+        {
+            return CY_HPI_MASTER_INVALID_ARGS;
+        }
+    }
+
+    for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+    {
+        fwuSlave            = &fwUpdate->ptrSlaves[idx];
+        fwuSlave->state     = CY_HPI_MASTER_FWU_STATE_ENTER;
+        fwuSlave->rowsDone  = 0U;
+        fwuSlave->response  = (uint8_t)CY_HPI_MASTER_RESPONSE_NO_RESPONSE;
+        fwuSlave->status    = CY_HPI_MASTER_SUCCESS;
+        fwuSlave->countdown = fwUpdate->timeout;
+    }
+    fwUpdate->activeCount = fwUpdate->slaveCount;
+    context->ptrFwUpdate  = fwUpdate;
+
+    for (idx = 0U; idx < fwUpdate->slaveCount; idx++)
+    {
+        fwuSlave         = &fwUpdate->ptrSlaves[idx];
+        fwuSlave->cmd[0] = CY_HPI_MASTER_ENTER_FLASHING_CMD_SIG;
+
+        status = Cy_HPI_Master_FwuWrite(context, fwuSlave, (uint16_t)CY_HPI_MASTER_DEV_REG_ENTER_FLASH_MODE,
+                                        fwuSlave->cmd, 1U);
+        if (status != CY_HPI_MASTER_SUCCESS)
+        {
+            Cy_HPI_Master_FwuFail(context, fwuSlave, status);
+        }
+    }
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+bool Cy_HPI_Master_FwUpdateIdle(cy_hpi_master_context_t *context)
+{
+    if ((context == NULL) || (context->ptrFwUpdate == NULL))
+    {
+        return true;
+    }
+
+    if (context->ptrFwUpdate->activeCount != 0U)
+    {
+        return false;
+    }
+
+    context->ptrFwUpdate = NULL;
+
+    return true;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_DevRegRead (cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 uint8_t deviceReg,
+                                                 uint8_t *readBuff,
+                                                 uint16_t readLen)
+{
+    return Cy_HPI_Master_RegisterRead(context, slaveAddr, deviceReg, readBuff, readLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_DevRegWrite(cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 uint8_t deviceReg,
+                                                 void *writeBuff,
+                                                 uint16_t writeLen)
+{
+    return Cy_HPI_Master_RegisterWrite(context, slaveAddr, deviceReg, writeBuff, writeLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_FlashMemoryRead (cy_hpi_master_context_t *context,
+                                                     uint8_t slaveAddr,
+                                                     uint8_t *readBuff,
+                                                     uint16_t readLen)
+{
+    return Cy_HPI_Master_RegisterRead(context, slaveAddr, CY_HPI_MASTER_FLASH_MEM_ADDR, readBuff, readLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_FlashMemoryWrite(cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 void *writeBuff,
+                                                 uint16_t writeLen)
+{
+    return Cy_HPI_Master_RegisterWrite(context, slaveAddr, CY_HPI_MASTER_FLASH_MEM_ADDR, writeBuff, writeLen);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PortSlaveLookup
+****************************************************************************//**
+*
+* Returns the index of the slave device accessed by address through a port
+* register API. The slave device is always looked up if the port register
+* cache is enabled.
+*
+*******************************************************************************/
+static uint8_t Cy_HPI_Master_PortSlaveLookup(cy_hpi_master_context_t *context, uint8_t slaveAddr)
+{
+    return (context->ptrPortCache != NULL) ? Cy_HPI_Master_GetSlaveIndexByAddr(context, slaveAddr) :
+                                             Cy_HPI_Master_SlaveLookup(context, slaveAddr);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PortRead
+****************************************************************************//**
+*
+* Reads port registers of a slave device, through the port register cache
+* if it is enabled.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_PortRead(cy_hpi_master_context_t *context,
+                                                     uint8_t slaveIdx,
+                                                     uint8_t slaveAddr,
+                                                     uint8_t port,
+                                                     uint8_t portReg,
+                                                     void *readBuff,
+                                                     uint16_t readLen)
+{
+    cy_hpi_master_port_cache_t *cache = NULL;
+    cy_hpi_master_status_t status;
+    uint32_t offset;
+    uint32_t first;
+    uint32_t last;
+    uint8_t mask;
+
+    if ((readBuff != NULL) && (readLen != 0U) &&
+        (portReg >= CY_HPI_MASTER_CACHE_REG_START) &&
+        (((uint32_t)portReg + readLen) <= (CY_HPI_MASTER_CACHE_REG_START + CY_HPI_MASTER_CACHE_REG_SIZE)))
+    {
+        cache = Cy_HPI_Master_GetPortCache(context, slaveIdx, port);
+    }
+
+    /* BUS_VOLTAGE is a live measurement and is never served from the cache. */
+    if ((portReg == (uint8_t)CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE) && (readLen == 1U))
+    {
+        cache = NULL;
+    }
+
+    if (cache == NULL)
+    {
+        return Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr,
+                                          (uint16_t)(((uint16_t)port + 1U) << 12) | portReg,
+                                          (uint8_t *)readBuff, readLen);
+    }
+
+    /* Registers are cached as whole 4-byte registers. */
+    offset = (uint32_t)portReg - CY_HPI_MASTER_CACHE_REG_START;
+    first  = offset >> 2;
+    last   = (offset + readLen - 1U) >> 2;
+    mask   = (uint8_t)(((1U << (last + 1U)) - 1U) & ~((1U << first) - 1U));
+
+    if ((cache->validMask & mask) != mask)
+    {
+        status = Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr,
+                                            (uint16_t)(((uint16_t)port + 1U) << 12) |
+                                            (uint16_t)(CY_HPI_MASTER_CACHE_REG_START + (first << 2)),
+                                            &cache->regs[first << 2], (uint16_t)((last - first + 1U) << 2));
+        if (status != CY_HPI_MASTER_SUCCESS)
+        {
+            return status;
+        }
+        cache->validMask |= mask;
+    }
+    else if ((portReg <= (uint8_t)CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE) &&
+             (((uint32_t)portReg + readLen) > (uint32_t)CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE))
+    {
+        /* Served from the cache: refresh the BUS_VOLTAGE byte from the device. */
+        status = Cy_HPI_Master_SlaveRegRead(context, slaveIdx, slaveAddr,
+                                            (uint16_t)(((uint16_t)port + 1U) << 12) |
+                                            (uint16_t)CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE,
+                                            &cache->regs[(uint32_t)CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE -
+                                                         CY_HPI_MASTER_CACHE_REG_START], 1U);
+        if (status != CY_HPI_MASTER_SUCCESS)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        /* Nothing to refresh. */
+    }
+
+    (void)memcpy(readBuff, &cache->regs[offset], readLen);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PortRegRead(cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 uint8_t port,
+                                                 uint8_t portReg,
+                                                 void *readBuff,
+                                                 uint16_t readLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_PortRead(context, Cy_HPI_Master_PortSlaveLookup(context, slaveAddr), slaveAddr, port,
+                                  portReg, readBuff, readLen);
+}
+
+void Cy_HPI_Master_PortCacheInvalidate(cy_hpi_master_context_t *context,
+                                       uint8_t slaveAddr,
+                                       uint8_t port)
+{
+    if (context != NULL)
+    {
+        Cy_HPI_Master_InvalidatePortCache(context, Cy_HPI_Master_GetSlaveIndexByAddr(context, slaveAddr),
+                                          port, CY_HPI_MASTER_CACHE_ALL);
+    }
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PortRegWrite(cy_hpi_master_context_t *context,
+                                                    uint8_t slaveAddr,
+                                                    uint8_t port,
+                                                    uint8_t portReg,
+                                                    void *writeBuff,
+                                                    uint16_t writeLen)
+{
+    uint8_t slaveIdx;
+
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    /* A port register write can change the port state, for example, by
+     * starting a PD command. */
+    slaveIdx = Cy_HPI_Master_PortSlaveLookup(context, slaveAddr);
+    Cy_HPI_Master_InvalidatePortCache(context, slaveIdx, port, CY_HPI_MASTER_CACHE_ALL);
+
+    return Cy_HPI_Master_SlaveRegWrite(context, slaveIdx, slaveAddr,
+                                       (uint16_t)(((uint16_t)port + 1U) << 12) | portReg, writeBuff, writeLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PortStatusRead(cy_hpi_master_context_t *context,
+                                                    uint8_t slaveAddr,
+                                                    uint8_t port,
+                                                    cy_hpi_master_port_status_t *status,
+                                                    bool readCurrent)
+{
+    uint8_t regs[CY_HPI_MASTER_PORT_STATUS_SIZE];
+    uint8_t busCurrent = 0U;
+    uint8_t slaveIdx;
+    cy_hpi_master_status_t result;
+
+    if ((context == NULL) || (status == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    /* PD_STATUS to CURRENT_RDO are contiguous. */
+    slaveIdx = Cy_HPI_Master_PortSlaveLookup(context, slaveAddr);
+    result   = Cy_HPI_Master_PortRead(context, slaveIdx, slaveAddr, port, CY_HPI_MASTER_PORT_REG_PD_STATUS,
+                                      regs, CY_HPI_MASTER_PORT_STATUS_SIZE);
+    if ((result == CY_HPI_MASTER_SUCCESS) && readCurrent)
+    {
+        result = Cy_HPI_Master_PortRead(context, slaveIdx, slaveAddr, port, CY_HPI_MASTER_PORT_REG_BUS_CURRENT,
+                                        &busCurrent, 1U);
+    }
+    if (result != CY_HPI_MASTER_SUCCESS)
+    {
+        return result;
+    }
+
+    status->pdStatus    = Cy_HPI_Master_GetU32(&regs[CY_HPI_MASTER_PORT_REG_PD_STATUS -
+                                                     CY_HPI_MASTER_PORT_REG_PD_STATUS]);
+    status->typeCStatus = regs[CY_HPI_MASTER_PORT_REG_TYPE_C_STATUS - CY_HPI_MASTER_PORT_REG_PD_STATUS];
+    status->busVoltage  = (uint16_t)((uint16_t)regs[CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE -
+                                                    CY_HPI_MASTER_PORT_REG_PD_STATUS] *
+                                     CY_HPI_MASTER_BUS_VOLTAGE_UNIT);
+    status->currentPdo  = Cy_HPI_Master_GetU32(&regs[CY_HPI_MASTER_PORT_REG_CURRENT_PDO -
+                                                     CY_HPI_MASTER_PORT_REG_PD_STATUS]);
+    status->currentRdo  = Cy_HPI_Master_GetU32(&regs[CY_HPI_MASTER_PORT_REG_CURRENT_RDO -
+                                                     CY_HPI_MASTER_PORT_REG_PD_STATUS]);
+    status->busCurrent  = (uint16_t)((uint16_t)busCurrent * CY_HPI_MASTER_BUS_CURRENT_UNIT);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegRead(cy_hpi_master_context_t *context,
+                                                 uint8_t slaveAddr,
+                                                 uint8_t port,
+                                                 uint16_t offset,
+                                                 void *readData,
+                                                 uint16_t readLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_PdResponseRead(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr,
+                                        port, offset, readData, readLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegWrite(cy_hpi_master_context_t *context,
+                                                    uint8_t slaveAddr,
+                                                    uint8_t port,
+                                                    uint16_t offset,
+                                                    void *writeBuff,
+                                                    uint16_t writeLen)
+{
+    return Cy_HPI_Master_RegisterWrite(context, slaveAddr,
+                                       (uint16_t)(((uint16_t)port + 1U) << 12) |
+                                       ((offset + CY_HPI_MASTER_PD_RESP_WRITE_OFFSET) & 0x0FFFU),
+                                       writeBuff, writeLen);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegReadv(cy_hpi_master_context_t *context,
+                                                        uint8_t slaveAddr,
+                                                        uint8_t port,
+                                                        const cy_hpi_master_pd_seg_t *segs,
+                                                        uint8_t segCount,
+                                                        uint8_t *scratch,
+                                                        uint16_t scratchLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_PdResponseSg(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr, port,
+                                      segs, segCount, scratch, scratchLen, CY_HPI_MASTER_PD_RESP_READ_OFFSET, false);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegWritev(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveAddr,
+                                                         uint8_t port,
+                                                         const cy_hpi_master_pd_seg_t *segs,
+                                                         uint8_t segCount,
+                                                         uint8_t *scratch,
+                                                         uint16_t scratchLen)
+{
+    if (context == NULL)
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    return Cy_HPI_Master_PdResponseSg(context, Cy_HPI_Master_SlaveLookup(context, slaveAddr), slaveAddr, port,
+                                      segs, segCount, scratch, scratchLen, CY_HPI_MASTER_PD_RESP_WRITE_OFFSET, true);
+}
+
+bool Cy_HPI_Master_SleepAllowed(cy_hpi_master_context_t *context)
+{
+    if (context == NULL)
+    {
+        return false;
+    }
+
+    if (context->ptrEventQueue == NULL)
+    {
+        return true;
+    }
+
+    return ((context->intrSummary == 0U) &&
+            (context->ptrEventQueue->headIdx == context->ptrEventQueue->tailIdx) &&
+            (Cy_HPI_Master_XferIdle(context)));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,603 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_bench.c
+* \version 1.1.0
+*
+* Scaling benchmark of the HPI master on a farm of simulated slave devices.
+*
+* The loopback slave devices provide the register maps. The I2C callbacks
+* wrap the loopback callbacks and advance a simulated clock by the bus time
+* of each transfer, computed from the bit time of the bus speed (9 bits per
+* byte plus the START, repeated START and STOP conditions), and by the
+* response latency of the slave device before it returns read data. Each
+* slave device raises port events at random times with the configured mean
+* rate, holds them until the previous event has been read, and asserts its
+* interrupt line, which is passed to the library through
+* Cy_HPI_Master_InterruptHandler.
+*
+* For each bus speed (100 kHz, 400 kHz and 1 MHz) and each slave device
+* count from 1 to 64, the benchmark reports the delivered events per second,
+* the 50th and 99th percentile of the latency from the generation of an
+* event to the call of the event handler, and the bus use. Only bus time is
+* simulated: the processing time of the library is not counted.
+*
+* Events are counted as lost when a slave device generates one while its
+* backlog is full, and as overflow when the library drops one because its
+* event queue is full; other errors reported by the library are counted
+* separately. Once the offered rate exceeds the capacity of the bus, the bus
+* use approaches 100%, the latency grows with the backlog of the slave
+* devices, and the excess events are lost. With round-robin scheduling (-s),
+* the slave devices are not serviced while queued events are left, so the
+* delivered rate levels off at the capacity of the bus and overflow stays at
+* zero.
+* With the default scheduling, Cy_HPI_Master_Task dispatches a queued event
+* only when no slave interrupt is pending, which on a saturated bus is
+* almost never: the delivered rate falls towards zero and the events stay in
+* the event queue until it overflows.
+*
+* Usage: hpimaster_bench [-r rate] [-n dataLen] [-l latencyUs] [-d seconds]
+*                        [-m maxSlaves] [-s] [-b evtBudget]
+*
+* -r  mean event rate of each slave device in events per second (50)
+* -n  event data length in bytes (8)
+* -l  response latency of the slave devices in us (20)
+* -d  simulated time of each run in seconds (2)
+* -m  largest slave device count (64)
+* -s  round-robin scheduling (CY_HPI_MASTER_SCHED_ROUND_ROBIN)
+* -b  maximum events dispatched per Cy_HPI_Master_Task call with -s (evtBudget, 0)
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "cy_hpi_master_loopback.h"
+
+/* Maximum number of simulated slave devices. */
+#define CY_HPI_MASTER_BENCH_MAX_SLAVES                (64U)
+
+/* I2C address of the first simulated slave device. */
+#define CY_HPI_MASTER_BENCH_BASE_ADDR                 (0x08U)
+
+/* Number of interrupt lines per simulated GPIO port. */
+#define CY_HPI_MASTER_BENCH_GPIO_PINS                 (8U)
+
+/* Number of events a simulated slave device holds before it loses events. */
+#define CY_HPI_MASTER_BENCH_BACKLOG                   (16U)
+
+/* Size of the event queue buffer. */
+#define CY_HPI_MASTER_BENCH_QUEUE_SIZE                (8192U)
+
+/* Size of the response buffer. */
+#define CY_HPI_MASTER_BENCH_RESP_SIZE                 (264U)
+
+/* Maximum event data length. */
+#define CY_HPI_MASTER_BENCH_MAX_DATA                  (256U)
+
+/* Bits of each transferred byte, including the acknowledge bit. */
+#define CY_HPI_MASTER_BENCH_BYTE_BITS                 (9U)
+
+/* Number of nanoseconds in one second. */
+#define CY_HPI_MASTER_BENCH_NS_PER_S                  (1000000000ULL)
+
+/* Number of nanoseconds in one microsecond. */
+#define CY_HPI_MASTER_BENCH_NS_PER_US                 (1000U)
+
+/* Simulated state of a slave device. */
+typedef struct cy_hpi_master_bench_slave
+{
+    /* Generation time of the next event in ns. */
+    uint64_t nextEvent;
+
+    /* Generation times of the events not yet delivered, oldest first. */
+    uint64_t backlog[CY_HPI_MASTER_BENCH_BACKLOG];
+
+    /* Index of the oldest event in backlog. */
+    uint8_t head;
+
+    /* Number of events in backlog. */
+    uint8_t count;
+
+    /* Number of events in backlog raised in the response registers. */
+    uint8_t raised;
+}cy_hpi_master_bench_slave_t;
+
+/* Result of one benchmark run. */
+typedef struct cy_hpi_master_bench_result
+{
+    /* Delivered events per second. */
+    double eventRate;
+
+    /* 50th percentile of the event latency in us. */
+    uint32_t p50;
+
+    /* 99th percentile of the event latency in us. */
+    uint32_t p99;
+
+    /* Bus use in percent. */
+    double busUse;
+
+    /* Number of events lost because the backlog of a slave device was full. */
+    uint32_t lost;
+
+    /* Number of events dropped because the event queue was full. */
+    uint32_t overflow;
+
+    /* Number of other errors reported by the library. */
+    uint32_t errors;
+}cy_hpi_master_bench_result_t;
+
+/* Simulated slave devices and their register maps. */
+static cy_hpi_master_loopback_t gl_HpiMasterBenchDevs[CY_HPI_MASTER_BENCH_MAX_SLAVES];
+static cy_hpi_master_bench_slave_t gl_HpiMasterBenchSlaves[CY_HPI_MASTER_BENCH_MAX_SLAVES];
+
+/* Simulated time, bus busy time, bit time and response latency in ns. */
+static uint64_t gl_HpiMasterBenchNow;
+static uint64_t gl_HpiMasterBenchBusy;
+static uint64_t gl_HpiMasterBenchBitTime;
+static uint64_t gl_HpiMasterBenchLatency;
+
+/* Event latencies of the current run in us. */
+static uint32_t *gl_HpiMasterBenchSamples;
+static uint32_t gl_HpiMasterBenchSampleCount;
+static uint32_t gl_HpiMasterBenchSampleSize;
+
+/* Number of other errors reported and of events dropped by the event queue
+ * in the current run. */
+static uint32_t gl_HpiMasterBenchErrors;
+static uint32_t gl_HpiMasterBenchDropped;
+
+/* State of the random number generator. */
+static uint32_t gl_HpiMasterBenchRandom = 0x2545F491U;
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchInterval
+****************************************************************************//**
+*
+* Returns a random time in ns to the next event of a slave device, with an
+* exponential distribution of mean 1 / rate.
+*
+*******************************************************************************/
+static uint64_t Cy_HPI_Master_BenchInterval(double rate)
+{
+    double uniform;
+
+    gl_HpiMasterBenchRandom ^= gl_HpiMasterBenchRandom << 13;
+    gl_HpiMasterBenchRandom ^= gl_HpiMasterBenchRandom >> 17;
+    gl_HpiMasterBenchRandom ^= gl_HpiMasterBenchRandom << 5;
+
+    /* Uniform in (0, 1]. */
+    uniform = ((double)(gl_HpiMasterBenchRandom >> 8) + 1.0) / 16777216.0;
+
+    return (uint64_t)(-log(uniform) * (double)CY_HPI_MASTER_BENCH_NS_PER_S / rate) + 1U;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchBusTime
+****************************************************************************//**
+*
+* Advances the simulated clock by the duration of a transfer of byteCount
+* bytes with condCount START, repeated START and STOP conditions.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_BenchBusTime(uint32_t byteCount, uint32_t condCount, bool read)
+{
+    uint64_t xferTime = (((uint64_t)byteCount * CY_HPI_MASTER_BENCH_BYTE_BITS) + condCount) *
+                        gl_HpiMasterBenchBitTime;
+
+    if (read)
+    {
+        /* The slave device stretches the clock until the data is ready. */
+        xferTime += gl_HpiMasterBenchLatency;
+    }
+
+    gl_HpiMasterBenchNow  += xferTime;
+    gl_HpiMasterBenchBusy += xferTime;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchI2cRead
+****************************************************************************//**
+*
+* I2C read callback: address write, register address, repeated START,
+* address read, data.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_BenchI2cRead(CySCB_Type *scbBase,
+                                       uint8_t slaveAddr,
+                                       uint8_t *buffer,
+                                       uint32_t count,
+                                       uint8_t *reg_addr,
+                                       uint8_t reg_size,
+                                       cy_stc_scb_i2c_context_t *i2cContext)
+{
+    Cy_HPI_Master_BenchBusTime(2U + reg_size + count, 3U, true);
+
+    return Cy_HPI_Master_LoopbackI2cRead(scbBase, slaveAddr, buffer, count, reg_addr, reg_size, i2cContext);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchI2cWrite
+****************************************************************************//**
+*
+* I2C write callback: address write, register address, data.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_BenchI2cWrite(CySCB_Type *scbBase,
+                                        uint8_t slaveAddr,
+                                        uint8_t *buffer,
+                                        uint32_t count,
+                                        uint8_t *reg_addr,
+                                        uint8_t reg_size,
+                                        cy_stc_scb_i2c_context_t *i2cContext)
+{
+    Cy_HPI_Master_BenchBusTime(1U + reg_size + count, 2U, false);
+
+    return Cy_HPI_Master_LoopbackI2cWrite(scbBase, slaveAddr, buffer, count, reg_addr, reg_size, i2cContext);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchI2cWriteRead
+****************************************************************************//**
+*
+* Combined write-read callback: address write, write data, repeated START,
+* address read, read data.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_BenchI2cWriteRead(CySCB_Type *scbBase,
+                                            uint8_t slaveAddr,
+                                            uint8_t *wrBuffer,
+                                            uint32_t wrCount,
+                                            uint8_t *rdBuffer,
+                                            uint32_t rdCount,
+                                            cy_stc_scb_i2c_context_t *i2cContext)
+{
+    Cy_HPI_Master_BenchBusTime(2U + wrCount + rdCount, 3U, true);
+
+    return Cy_HPI_Master_LoopbackI2cWriteRead(scbBase, slaveAddr, wrBuffer, wrCount, rdBuffer, rdCount,
+                                              i2cContext);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchEvent
+****************************************************************************//**
+*
+* Event handler: records the latency of the oldest event of the slave device.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_BenchEvent(struct cy_hpi_master_context *context, cy_hpi_master_event_t *event)
+{
+    cy_hpi_master_bench_slave_t *slave = &gl_HpiMasterBenchSlaves[event->slaveDev - context->ptrSlaves];
+
+    if ((slave->raised == 0U) || (event->eventCode != CY_HPI_MASTER_EVENT_NEGOTIATION_COMPLETE))
+    {
+        return true;
+    }
+
+    if (gl_HpiMasterBenchSampleCount < gl_HpiMasterBenchSampleSize)
+    {
+        gl_HpiMasterBenchSamples[gl_HpiMasterBenchSampleCount++] =
+            (uint32_t)((gl_HpiMasterBenchNow - slave->backlog[slave->head]) / CY_HPI_MASTER_BENCH_NS_PER_US);
+    }
+
+    slave->head = (uint8_t)((slave->head + 1U) % CY_HPI_MASTER_BENCH_BACKLOG);
+    slave->count--;
+    slave->raised--;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchError
+****************************************************************************//**
+*
+* Error handler: counts the errors. An event dropped because the event queue
+* is full is counted apart from the other errors; it is the newest raised
+* event of the slave device, and is removed from its backlog.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_BenchError(struct cy_hpi_master_context *context, cy_hpi_master_event_t *event)
+{
+    cy_hpi_master_bench_slave_t *slave;
+    uint8_t pos;
+
+    if (event->eventCode != (uint8_t)CY_HPI_MASTER_QUEUE_OVERFLOW)
+    {
+        gl_HpiMasterBenchErrors++;
+        return true;
+    }
+
+    gl_HpiMasterBenchDropped++;
+
+    if (event->slaveDev != NULL)
+    {
+        slave = &gl_HpiMasterBenchSlaves[event->slaveDev - context->ptrSlaves];
+        if (slave->raised != 0U)
+        {
+            for (pos = slave->raised; pos < slave->count; pos++)
+            {
+                slave->backlog[(slave->head + pos - 1U) % CY_HPI_MASTER_BENCH_BACKLOG] =
+                    slave->backlog[(slave->head + pos) % CY_HPI_MASTER_BENCH_BACKLOG];
+            }
+            slave->count--;
+            slave->raised--;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchCompare
+****************************************************************************//**
+*
+* Comparison function of the latency samples for qsort.
+*
+*******************************************************************************/
+static int Cy_HPI_Master_BenchCompare(const void *a, const void *b)
+{
+    uint32_t valA = *(const uint32_t *)a;
+    uint32_t valB = *(const uint32_t *)b;
+
+    return (valA > valB) - (valA < valB);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BenchRun
+****************************************************************************//**
+*
+* Runs the HPI master on slaveCount simulated slave devices for duration ns
+* of simulated time.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_BenchRun(uint8_t slaveCount,
+                                   uint8_t schedFlags,
+                                   uint8_t evtBudget,
+                                   uint32_t busHz,
+                                   double rate,
+                                   uint16_t dataLen,
+                                   uint64_t duration,
+                                   cy_hpi_master_bench_result_t *result)
+{
+    static cy_hpi_master_slave_dev_t slaveDevs[CY_HPI_MASTER_BENCH_MAX_SLAVES];
+    static uint32_t intrMask[CY_HPI_MASTER_INTR_MASK_WORDS(CY_HPI_MASTER_BENCH_MAX_SLAVES)];
+    static uint32_t prioMask[CY_HPI_MASTER_INTR_MASK_WORDS(CY_HPI_MASTER_BENCH_MAX_SLAVES)];
+    static uint8_t queueBuff[CY_HPI_MASTER_BENCH_QUEUE_SIZE];
+    static uint8_t respBuff[CY_HPI_MASTER_BENCH_RESP_SIZE];
+    uint8_t data[CY_HPI_MASTER_BENCH_MAX_DATA] = {0U};
+    cy_hpi_master_bench_slave_t *slave;
+    cy_hpi_master_loopback_bus_t loopbackBus;
+    cy_hpi_master_event_queue_t queue;
+    cy_hpi_master_app_cbk_t appCbk;
+    cy_stc_scb_i2c_context_t i2cContext;
+    CySCB_Type adapter;
+    uint64_t nextEvent;
+    uint64_t before;
+    uint32_t delivered;
+    uint32_t lost = 0U;
+    uint8_t idx;
+
+    cy_hpi_master_context_t context =
+    {
+        .ptrEventQueue   = &queue,
+        .maxSlaveDevices = CY_HPI_MASTER_BENCH_MAX_SLAVES,
+        .ptrSlaves       = slaveDevs,
+        .ptrScbBase      = &adapter,
+        .ptrI2cContext   = &i2cContext,
+        .respBuffLen     = CY_HPI_MASTER_BENCH_RESP_SIZE,
+        .ptrRespBuff     = respBuff,
+        .ptrIntrMask     = intrMask,
+        .ptrPrioMask     = prioMask,
+        .schedFlags      = schedFlags,
+        .evtBudget       = evtBudget,
+        .respPrefetchLen = dataLen,
+    };
+
+    (void)memset(&queue, 0, sizeof(queue));
+    queue.startAddress = queueBuff;
+    queue.bufferSize   = CY_HPI_MASTER_BENCH_QUEUE_SIZE;
+
+    (void)memset(&appCbk, 0, sizeof(appCbk));
+    appCbk.i2c_master_read       = Cy_HPI_Master_BenchI2cRead;
+    appCbk.i2c_master_write      = Cy_HPI_Master_BenchI2cWrite;
+    appCbk.i2c_master_write_read = Cy_HPI_Master_BenchI2cWriteRead;
+    appCbk.i2cCaps               = CY_HPI_MASTER_I2C_CAP_REPEATED_START;
+    appCbk.event_handler         = Cy_HPI_Master_BenchEvent;
+    appCbk.error_handler         = Cy_HPI_Master_BenchError;
+
+    loopbackBus.ptrSlaves  = gl_HpiMasterBenchDevs;
+    loopbackBus.slaveCount = slaveCount;
+    Cy_HPI_Master_LoopbackAttach(&adapter, &loopbackBus);
+
+    gl_HpiMasterBenchNow         = 0U;
+    gl_HpiMasterBenchBusy        = 0U;
+    gl_HpiMasterBenchBitTime     = CY_HPI_MASTER_BENCH_NS_PER_S / busHz;
+    gl_HpiMasterBenchSampleCount = 0U;
+    gl_HpiMasterBenchErrors      = 0U;
+    gl_HpiMasterBenchDropped     = 0U;
+
+    (void)Cy_HPI_Master_Init(&context, &appCbk);
+
+    for (idx = 0U; idx < slaveCount; idx++)
+    {
+        Cy_HPI_Master_LoopbackInit(&gl_HpiMasterBenchDevs[idx], CY_HPI_MASTER_BENCH_BASE_ADDR + idx, 1U, 0U);
+        (void)Cy_HPI_Master_SlaveDeviceInit(&context, CY_HPI_MASTER_BENCH_BASE_ADDR + idx,
+                                            idx / CY_HPI_MASTER_BENCH_GPIO_PINS,
+                                            idx % CY_HPI_MASTER_BENCH_GPIO_PINS, 1U);
+
+        (void)memset(&gl_HpiMasterBenchSlaves[idx], 0, sizeof(cy_hpi_master_bench_slave_t));
+        gl_HpiMasterBenchSlaves[idx].nextEvent = Cy_HPI_Master_BenchInterval(rate);
+    }
+
+    while (gl_HpiMasterBenchNow < duration)
+    {
+        nextEvent = UINT64_MAX;
+
+        for (idx = 0U; idx < slaveCount; idx++)
+        {
+            slave = &gl_HpiMasterBenchSlaves[idx];
+
+            /* Generate the events which are due. */
+            while (slave->nextEvent <= gl_HpiMasterBenchNow)
+            {
+                if (slave->count < CY_HPI_MASTER_BENCH_BACKLOG)
+                {
+                    slave->backlog[(slave->head + slave->count) % CY_HPI_MASTER_BENCH_BACKLOG] = slave->nextEvent;
+                    slave->count++;
+                }
+                else
+                {
+                    lost++;
+                }
+                slave->nextEvent += Cy_HPI_Master_BenchInterval(rate);
+            }
+
+            if (slave->nextEvent < nextEvent)
+            {
+                nextEvent = slave->nextEvent;
+            }
+
+            /* Raise the next event once the previous one has been read. */
+            if ((slave->raised < slave->count) && (!Cy_HPI_Master_LoopbackIntrAsserted(&gl_HpiMasterBenchDevs[idx])))
+            {
+                (void)Cy_HPI_Master_LoopbackPortEvent(&gl_HpiMasterBenchDevs[idx], CY_HPI_MASTER_PORT_NUMBER_0,
+                                                      CY_HPI_MASTER_EVENT_NEGOTIATION_COMPLETE, data, dataLen);
+                slave->raised++;
+            }
+
+            if (Cy_HPI_Master_LoopbackIntrAsserted(&gl_HpiMasterBenchDevs[idx]))
+            {
+                Cy_HPI_Master_InterruptHandler(&context, idx / CY_HPI_MASTER_BENCH_GPIO_PINS,
+                                               idx % CY_HPI_MASTER_BENCH_GPIO_PINS);
+            }
+        }
+
+        before    = gl_HpiMasterBenchNow;
+        delivered = gl_HpiMasterBenchSampleCount;
+
+        Cy_HPI_Master_Task(&context);
+
+        if ((gl_HpiMasterBenchNow == before) && (gl_HpiMasterBenchSampleCount == delivered))
+        {
+            /* Nothing to do until the next event. */
+            gl_HpiMasterBenchNow = nextEvent;
+        }
+    }
+
+    result->eventRate = (double)gl_HpiMasterBenchSampleCount * (double)CY_HPI_MASTER_BENCH_NS_PER_S /
+                        (double)gl_HpiMasterBenchNow;
+    result->busUse    = 100.0 * (double)gl_HpiMasterBenchBusy / (double)gl_HpiMasterBenchNow;
+    result->lost      = lost;
+    result->overflow  = gl_HpiMasterBenchDropped;
+    result->errors    = gl_HpiMasterBenchErrors;
+    result->p50       = 0U;
+    result->p99       = 0U;
+
+    if (gl_HpiMasterBenchSampleCount != 0U)
+    {
+        qsort(gl_HpiMasterBenchSamples, gl_HpiMasterBenchSampleCount, sizeof(uint32_t),
+              Cy_HPI_Master_BenchCompare);
+        result->p50 = gl_HpiMasterBenchSamples[((gl_HpiMasterBenchSampleCount - 1U) * 50U) / 100U];
+        result->p99 = gl_HpiMasterBenchSamples[((gl_HpiMasterBenchSampleCount - 1U) * 99U) / 100U];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t busSpeeds[] = {100000U, 400000U, 1000000U};
+    cy_hpi_master_bench_result_t result;
+    double rate = 50.0;
+    double seconds = 2.0;
+    uint32_t latencyUs = 20U;
+    uint32_t dataLen = 8U;
+    uint32_t maxSlaves = CY_HPI_MASTER_BENCH_MAX_SLAVES;
+    uint8_t schedFlags = 0U;
+    uint32_t evtBudget = 0U;
+    uint32_t speedIdx;
+    uint32_t slaveCount;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:n:l:d:m:sb:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r':
+                rate = atof(optarg);
+                break;
+            case 'n':
+                dataLen = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                latencyUs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                seconds = atof(optarg);
+                break;
+            case 'm':
+                maxSlaves = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                schedFlags = CY_HPI_MASTER_SCHED_ROUND_ROBIN;
+                break;
+            case 'b':
+                evtBudget = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-r rate] [-n dataLen] [-l latencyUs] [-d seconds] "
+                              "[-m maxSlaves] [-s] [-b evtBudget]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if ((rate <= 0.0) || (seconds <= 0.0) || (dataLen > CY_HPI_MASTER_BENCH_MAX_DATA) ||
+        (maxSlaves == 0U) || (maxSlaves > CY_HPI_MASTER_BENCH_MAX_SLAVES) || (evtBudget > UINT8_MAX))
+    {
+        (void)fprintf(stderr, "%s: invalid arguments\n", argv[0]);
+        return 1;
+    }
+
+    gl_HpiMasterBenchLatency    = (uint64_t)latencyUs * CY_HPI_MASTER_BENCH_NS_PER_US;
+    gl_HpiMasterBenchSampleSize = (uint32_t)(rate * seconds * (double)maxSlaves * 2.0) + 1024U;
+    gl_HpiMasterBenchSamples    = malloc(gl_HpiMasterBenchSampleSize * sizeof(uint32_t));
+    if (gl_HpiMasterBenchSamples == NULL)
+    {
+        (void)fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    (void)printf("%.1f events/s per slave, %u data bytes, %u us response latency, %.1f s, %s scheduling\n",
+                 rate, dataLen, latencyUs, seconds, (schedFlags != 0U) ? "round-robin" : "default");
+    (void)printf("%8s %6s %10s %10s %10s %10s %8s %6s %8s %6s\n",
+                 "bus", "slaves", "offered/s", "events/s", "p50 us", "p99 us", "bus use", "lost", "overflow",
+                 "errors");
+
+    for (speedIdx = 0U; speedIdx < (sizeof(busSpeeds) / sizeof(busSpeeds[0])); speedIdx++)
+    {
+        for (slaveCount = 1U; slaveCount <= maxSlaves; slaveCount *= 2U)
+        {
+            Cy_HPI_Master_BenchRun((uint8_t)slaveCount, schedFlags, (uint8_t)evtBudget, busSpeeds[speedIdx], rate,
+                                   (uint16_t)dataLen, (uint64_t)(seconds * (double)CY_HPI_MASTER_BENCH_NS_PER_S),
+                                   &result);
+
+            (void)printf("%7uk %6u %10.1f %10.1f %10u %10u %7.1f%% %6u %8u %6u\n",
+                         busSpeeds[speedIdx] / 1000U, slaveCount, rate * (double)slaveCount, result.eventRate,
+                         result.p50, result.p99, result.busUse, result.lost, result.overflow, result.errors);
+        }
+    }
+
+    free(gl_HpiMasterBenchSamples);
+
+    return 0;
+}
+
+/* [] END OF FILE */
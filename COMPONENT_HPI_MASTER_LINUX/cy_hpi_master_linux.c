@@ -0,0 +1,373 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_linux.c
+* \version 1.1.0
+*
+* Implements the Linux user-space backend of the HPI master middleware.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _XOPEN_SOURCE 700
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "cy_hpi_master_linux.h"
+
+/* Maximum register address length in bytes. */
+#define CY_HPI_MASTER_LINUX_MAX_REG_SIZE              (2U)
+
+/* Consumer label of the requested GPIO lines. */
+#define CY_HPI_MASTER_LINUX_CONSUMER                  "hpi-master"
+
+/* Number of line events read from a line request at once. */
+#define CY_HPI_MASTER_LINUX_EVT_COUNT                 (4U)
+
+/* Critical section shared by the HPI master and the backend threads. */
+static pthread_mutex_t gl_HpiMasterLinuxLock;
+static pthread_once_t gl_HpiMasterLinuxLockOnce = PTHREAD_ONCE_INIT;
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_LinuxLockInit
+****************************************************************************//**
+*
+* Creates the recursive mutex which implements the critical section.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_LinuxLockInit(void)
+{
+    pthread_mutexattr_t attr;
+
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutex_init(&gl_HpiMasterLinuxLock, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    (void)pthread_once(&gl_HpiMasterLinuxLockOnce, Cy_HPI_Master_LinuxLockInit);
+    (void)pthread_mutex_lock(&gl_HpiMasterLinuxLock);
+
+    return 0U;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    (void)savedIntrStatus;
+    (void)pthread_mutex_unlock(&gl_HpiMasterLinuxLock);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    struct timespec delay;
+
+    delay.tv_sec  = 0;
+    delay.tv_nsec = (long)microseconds * 1000L;
+
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+    {
+    }
+}
+
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    struct gpio_v2_line_values values;
+
+    values.bits = 0U;
+    values.mask = 1ULL << pinNum;
+
+    /* A line which cannot be read is reported high (released). */
+    if (ioctl(base->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+    {
+        return 1U;
+    }
+
+    return ((values.bits & values.mask) != 0U) ? 1U : 0U;
+}
+
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value)
+{
+    struct gpio_v2_line_values values;
+
+    values.mask = 1ULL << pinNum;
+    values.bits = (value != 0U) ? values.mask : 0U;
+
+    (void)ioctl(base->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values);
+}
+
+en_hsiom_sel_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+
+    return HSIOM_SEL_GPIO;
+}
+
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, en_hsiom_sel_t value)
+{
+    (void)base;
+    (void)pinNum;
+    (void)value;
+}
+
+uint32_t Cy_GPIO_GetDrivemode(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+
+    return CY_GPIO_DM_OD_DRIVESLOW;
+}
+
+void Cy_GPIO_SetDrivemode(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value)
+{
+    (void)base;
+    (void)pinNum;
+    (void)value;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_LinuxBusOpen(CySCB_Type *scbBase, const char *devPath)
+{
+    if ((scbBase == NULL) || (devPath == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    scbBase->userData = NULL;
+    scbBase->fd       = open(devPath, O_RDWR | O_CLOEXEC);
+
+    return (scbBase->fd >= 0) ? CY_HPI_MASTER_SUCCESS : CY_HPI_MASTER_FAILURE;
+}
+
+void Cy_HPI_Master_LinuxBusClose(CySCB_Type *scbBase)
+{
+    if ((scbBase != NULL) && (scbBase->fd >= 0))
+    {
+        (void)close(scbBase->fd);
+        scbBase->fd = -1;
+    }
+}
+
+bool Cy_HPI_Master_LinuxI2cRead(CySCB_Type *scbBase,
+                                uint8_t slaveAddr,
+                                uint8_t *buffer,
+                                uint32_t count,
+                                uint8_t *reg_addr,
+                                uint8_t reg_size,
+                                cy_stc_scb_i2c_context_t *i2cContext)
+{
+    return Cy_HPI_Master_LinuxI2cWriteRead(scbBase, slaveAddr, reg_addr, reg_size, buffer, count, i2cContext);
+}
+
+bool Cy_HPI_Master_LinuxI2cWriteRead(CySCB_Type *scbBase,
+                                     uint8_t slaveAddr,
+                                     uint8_t *wrBuffer,
+                                     uint32_t wrCount,
+                                     uint8_t *rdBuffer,
+                                     uint32_t rdCount,
+                                     cy_stc_scb_i2c_context_t *i2cContext)
+{
+    struct i2c_msg msgs[2];
+    struct i2c_rdwr_ioctl_data xfer;
+
+    (void)i2cContext;
+
+    if ((wrCount > UINT16_MAX) || (rdCount == 0U) || (rdCount > UINT16_MAX))
+    {
+        return false;
+    }
+
+    msgs[0].addr  = slaveAddr;
+    msgs[0].flags = 0U;
+    msgs[0].len   = (uint16_t)wrCount;
+    msgs[0].buf   = wrBuffer;
+
+    msgs[1].addr  = slaveAddr;
+    msgs[1].flags = I2C_M_RD;
+    msgs[1].len   = (uint16_t)rdCount;
+    msgs[1].buf   = rdBuffer;
+
+    xfer.msgs  = msgs;
+    xfer.nmsgs = 2U;
+
+    return (ioctl(scbBase->fd, I2C_RDWR, &xfer) == 2);
+}
+
+bool Cy_HPI_Master_LinuxI2cWrite(CySCB_Type *scbBase,
+                                 uint8_t slaveAddr,
+                                 uint8_t *buffer,
+                                 uint32_t count,
+                                 uint8_t *reg_addr,
+                                 uint8_t reg_size,
+                                 cy_stc_scb_i2c_context_t *i2cContext)
+{
+    uint8_t data[CY_HPI_MASTER_LINUX_MAX_REG_SIZE + CY_HPI_MASTER_LINUX_MAX_WRITE];
+    struct i2c_msg msg;
+    struct i2c_rdwr_ioctl_data xfer;
+
+    (void)i2cContext;
+
+    if ((reg_size > CY_HPI_MASTER_LINUX_MAX_REG_SIZE) || (count > CY_HPI_MASTER_LINUX_MAX_WRITE))
+    {
+        return false;
+    }
+
+    /* The register address and the data must be one message: a second
+     * message would start with a repeated start and the address again. */
+    (void)memcpy(data, reg_addr, reg_size);
+    if (count != 0U)
+    {
+        (void)memcpy(&data[reg_size], buffer, count);
+    }
+
+    msg.addr  = slaveAddr;
+    msg.flags = 0U;
+    msg.len   = (uint16_t)(reg_size + count);
+    msg.buf   = data;
+
+    xfer.msgs  = &msg;
+    xfer.nmsgs = 1U;
+
+    return (ioctl(scbBase->fd, I2C_RDWR, &xfer) == 1);
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_LinuxIntrOpen(cy_hpi_master_linux_intr_t *intr,
+                                                   const char *chipPath,
+                                                   uint32_t line,
+                                                   uint8_t slaveIdx)
+{
+    struct gpio_v2_line_request req;
+    int chipFd;
+    int result;
+
+    if ((intr == NULL) || (chipPath == NULL))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    intr->fd       = -1;
+    intr->slaveIdx = slaveIdx;
+
+    chipFd = open(chipPath, O_RDWR | O_CLOEXEC);
+    if (chipFd < 0)
+    {
+        return CY_HPI_MASTER_FAILURE;
+    }
+
+    (void)memset(&req, 0, sizeof(req));
+    req.offsets[0]   = line;
+    req.num_lines    = 1U;
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    (void)strncpy(req.consumer, CY_HPI_MASTER_LINUX_CONSUMER, sizeof(req.consumer) - 1U);
+
+    result = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &req);
+    (void)close(chipFd);
+
+    if (result < 0)
+    {
+        return CY_HPI_MASTER_FAILURE;
+    }
+
+    intr->fd = req.fd;
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+void Cy_HPI_Master_LinuxIntrClose(cy_hpi_master_linux_intr_t *intr)
+{
+    if ((intr != NULL) && (intr->fd >= 0))
+    {
+        (void)close(intr->fd);
+        intr->fd = -1;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_LinuxIntrScan
+****************************************************************************//**
+*
+* Marks the slave devices whose interrupt line is low as pending, and
+* returns their number.
+*
+*******************************************************************************/
+static int Cy_HPI_Master_LinuxIntrScan(cy_hpi_master_context_t *context,
+                                       cy_hpi_master_linux_intr_t *intr,
+                                       uint8_t intrCount)
+{
+    GPIO_PRT_Type port;
+    int count = 0;
+    uint8_t idx;
+
+    for (idx = 0U; idx < intrCount; idx++)
+    {
+        port.fd = intr[idx].fd;
+        if ((intr[idx].fd >= 0) && (Cy_GPIO_Read(&port, 0U) == 0U))
+        {
+            Cy_HPI_Master_SlaveInterruptHandler(context, intr[idx].slaveIdx);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+int Cy_HPI_Master_LinuxIntrWait(cy_hpi_master_context_t *context,
+                                cy_hpi_master_linux_intr_t *intr,
+                                uint8_t intrCount,
+                                int timeoutMs)
+{
+    struct pollfd fds[UINT8_MAX];
+    struct gpio_v2_line_event events[CY_HPI_MASTER_LINUX_EVT_COUNT];
+    int count;
+    uint8_t idx;
+
+    if ((context == NULL) || (intr == NULL))
+    {
+        return -1;
+    }
+
+    count = Cy_HPI_Master_LinuxIntrScan(context, intr, intrCount);
+    if (count != 0)
+    {
+        return count;
+    }
+
+    for (idx = 0U; idx < intrCount; idx++)
+    {
+        fds[idx].fd      = intr[idx].fd;
+        fds[idx].events  = POLLIN;
+        fds[idx].revents = 0;
+    }
+
+    if (poll(fds, intrCount, timeoutMs) < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    for (idx = 0U; idx < intrCount; idx++)
+    {
+        if ((fds[idx].revents & POLLIN) != 0)
+        {
+            /* Drain the edge events; the line level decides. */
+            (void)read(intr[idx].fd, events, sizeof(events));
+        }
+    }
+
+    return Cy_HPI_Master_LinuxIntrScan(context, intr, intrCount);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,325 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_linux.h
+* \version 1.1.0
+*
+* Defines the Linux user-space backend of the HPI master middleware.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_HPI_MASTER_LINUX_H
+#define CY_HPI_MASTER_LINUX_H
+
+#include <stdint.h>
+#include "cy_hpi_master.h"
+
+/**
+********************************************************************************
+* \addtogroup group_hpim_linux
+* \{
+*
+* The Linux backend runs the HPI master on a Linux host, such as a BMC, which
+* is connected to the HPI slave devices through an i2c-dev adapter.
+*
+* Each register read is one I2C_RDWR ioctl with two messages, the register
+* address write and the data read, so the kernel executes it as a single
+* transfer with a repeated start. Set the i2cCaps member of the application
+* callbacks to CY_HPI_MASTER_I2C_CAP_REPEATED_START, or use
+* \ref Cy_HPI_Master_LinuxI2cWriteRead as the i2c_master_write_read callback.
+* Each register write is one I2C_RDWR message.
+*
+* The slave interrupt lines are requested from the GPIO character device with
+* falling edge detection. \ref Cy_HPI_Master_LinuxIntrWait blocks until a line
+* is asserted and marks the slave device pending, so that the main loop can
+* call \ref Cy_HPI_Master_Task.
+*
+* The kernel I2C driver recovers a stuck bus itself. Leave the sclPort and
+* sdaPort members of the buses NULL.
+*
+* Build the host library with the Makefile in this directory. The directory
+* is listed in .cyignore, so ModusToolbox builds for the target skip it.
+*
+* A typical main loop:
+* \code
+* static CySCB_Type adapter;
+* static cy_hpi_master_linux_intr_t intr[2];
+*
+* Cy_HPI_Master_LinuxBusOpen(&adapter, "/dev/i2c-1");
+* // context.ptrScbBase = &adapter, i2c_master_read = Cy_HPI_Master_LinuxI2cRead, ...
+* Cy_HPI_Master_Init(&context, &appCbk);
+* Cy_HPI_Master_SlaveDeviceInit(&context, 0x08, 0, 0, 2);
+* Cy_HPI_Master_SlaveDeviceInit(&context, 0x40, 0, 1, 2);
+* Cy_HPI_Master_LinuxIntrOpen(&intr[0], "/dev/gpiochip0", 17, 0);
+* Cy_HPI_Master_LinuxIntrOpen(&intr[1], "/dev/gpiochip0", 27, 1);
+*
+* for (;;)
+* {
+*     (void)Cy_HPI_Master_LinuxIntrWait(&context, intr, 2, 100);
+*     Cy_HPI_Master_Task(&context);
+* }
+* \endcode
+*
+********************************************************************************
+* \} */
+
+/**
+* \addtogroup group_hpim_linux
+* \{
+*/
+
+/** Maximum number of data bytes in one register write. */
+#define CY_HPI_MASTER_LINUX_MAX_WRITE                 (512U)
+
+/**
+* @brief Interrupt line of a slave device.
+*/
+typedef struct cy_hpi_master_linux_intr
+{
+    /** File descriptor of the line request. -1 if the line is not opened. */
+    int fd;
+
+    /** Index of the slave device the line belongs to. */
+    uint8_t slaveIdx;
+}cy_hpi_master_linux_intr_t;
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxBusOpen
+****************************************************************************//**
+*
+* Opens an i2c-dev adapter.
+*
+* \param scbBase
+* Adapter to be passed as ptrScbBase or as the ptrScbBase member of a bus.
+*
+* \param devPath
+* Path of the adapter, for example "/dev/i2c-1".
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the adapter is opened.
+* CY_HPI_MASTER_FAILURE - If the adapter cannot be opened.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_LinuxBusOpen(CySCB_Type *scbBase, const char *devPath);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxBusClose
+****************************************************************************//**
+*
+* Closes an i2c-dev adapter.
+*
+* \param scbBase
+* Adapter opened with \ref Cy_HPI_Master_LinuxBusOpen.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_LinuxBusClose(CySCB_Type *scbBase);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxI2cRead
+****************************************************************************//**
+*
+* I2C read callback (i2c_master_read) of the Linux backend. Writes the
+* register address and reads the data in one combined transfer.
+*
+* \param scbBase
+* Adapter opened with \ref Cy_HPI_Master_LinuxBusOpen.
+*
+* \param slaveAddr
+* I2C slave address (7 bits).
+*
+* \param buffer
+* Read data buffer.
+*
+* \param count
+* Number of bytes to read.
+*
+* \param reg_addr
+* Register address.
+*
+* \param reg_size
+* Register address length in bytes.
+*
+* \param i2cContext
+* Not used.
+*
+* \return
+* true if the transfer succeeded, false otherwise.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LinuxI2cRead(CySCB_Type *scbBase,
+                                uint8_t slaveAddr,
+                                uint8_t *buffer,
+                                uint32_t count,
+                                uint8_t *reg_addr,
+                                uint8_t reg_size,
+                                cy_stc_scb_i2c_context_t *i2cContext);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxI2cWrite
+****************************************************************************//**
+*
+* I2C write callback (i2c_master_write) of the Linux backend. Writes the
+* register address and the data in one transfer.
+*
+* \param scbBase
+* Adapter opened with \ref Cy_HPI_Master_LinuxBusOpen.
+*
+* \param slaveAddr
+* I2C slave address (7 bits).
+*
+* \param buffer
+* Write data buffer.
+*
+* \param count
+* Number of bytes to write, up to CY_HPI_MASTER_LINUX_MAX_WRITE.
+*
+* \param reg_addr
+* Register address.
+*
+* \param reg_size
+* Register address length in bytes.
+*
+* \param i2cContext
+* Not used.
+*
+* \return
+* true if the transfer succeeded, false otherwise.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LinuxI2cWrite(CySCB_Type *scbBase,
+                                 uint8_t slaveAddr,
+                                 uint8_t *buffer,
+                                 uint32_t count,
+                                 uint8_t *reg_addr,
+                                 uint8_t reg_size,
+                                 cy_stc_scb_i2c_context_t *i2cContext);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxI2cWriteRead
+****************************************************************************//**
+*
+* Combined write-read callback (i2c_master_write_read) of the Linux backend.
+* Writes and then reads in one transfer with a repeated start.
+*
+* \param scbBase
+* Adapter opened with \ref Cy_HPI_Master_LinuxBusOpen.
+*
+* \param slaveAddr
+* I2C slave address (7 bits).
+*
+* \param wrBuffer
+* Write data buffer.
+*
+* \param wrCount
+* Number of bytes to write.
+*
+* \param rdBuffer
+* Read data buffer.
+*
+* \param rdCount
+* Number of bytes to read.
+*
+* \param i2cContext
+* Not used.
+*
+* \return
+* true if the transfer succeeded, false otherwise.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LinuxI2cWriteRead(CySCB_Type *scbBase,
+                                     uint8_t slaveAddr,
+                                     uint8_t *wrBuffer,
+                                     uint32_t wrCount,
+                                     uint8_t *rdBuffer,
+                                     uint32_t rdCount,
+                                     cy_stc_scb_i2c_context_t *i2cContext);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxIntrOpen
+****************************************************************************//**
+*
+* Requests the interrupt line of a slave device from a GPIO character device,
+* as an input with falling edge detection.
+*
+* \param intr
+* Interrupt line structure to initialize.
+*
+* \param chipPath
+* Path of the GPIO chip, for example "/dev/gpiochip0".
+*
+* \param line
+* Line offset within the chip.
+*
+* \param slaveIdx
+* Index of the slave device.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the line is requested.
+* CY_HPI_MASTER_FAILURE - If the line cannot be requested.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_LinuxIntrOpen(cy_hpi_master_linux_intr_t *intr,
+                                                   const char *chipPath,
+                                                   uint32_t line,
+                                                   uint8_t slaveIdx);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxIntrClose
+****************************************************************************//**
+*
+* Releases an interrupt line.
+*
+* \param intr
+* Interrupt line opened with \ref Cy_HPI_Master_LinuxIntrOpen.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_LinuxIntrClose(cy_hpi_master_linux_intr_t *intr);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LinuxIntrWait
+****************************************************************************//**
+*
+* Marks the slave devices whose interrupt line is low as pending, and waits
+* for a falling edge if none is. The HPI interrupt is level triggered, so a
+* line which stays low after its interrupt is cleared is found on the next
+* call.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param intr
+* Array of interrupt lines.
+*
+* \param intrCount
+* Number of interrupt lines.
+*
+* \param timeoutMs
+* Longest time to wait in milliseconds. -1 waits without a limit.
+*
+* \return
+* Number of slave devices marked pending, 0 on timeout, or -1 on error.
+*
+*******************************************************************************/
+int Cy_HPI_Master_LinuxIntrWait(cy_hpi_master_context_t *context,
+                                cy_hpi_master_linux_intr_t *intr,
+                                uint8_t intrCount,
+                                int timeoutMs);
+
+/** \} group_hpim_linux */
+
+#endif /* CY_HPI_MASTER_LINUX_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,248 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_loopback.c
+* \version 1.1.0
+*
+* Implements the loopback HPI slave devices of the HPI master host build.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_hpi_master_loopback.h"
+
+/* Offset of the response registers in a port region. */
+#define CY_HPI_MASTER_LOOPBACK_PORT_RESP              (0x0400U)
+
+/* Size of the port response header: code, reserved, length (2 bytes). */
+#define CY_HPI_MASTER_LOOPBACK_RESP_HDR_SIZE          (4U)
+
+/* Firmware mode reported in the Device Mode register (FW1). */
+#define CY_HPI_MASTER_LOOPBACK_FW_MODE                (0x01U)
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_LoopbackFind
+****************************************************************************//**
+*
+* Returns the simulated slave device with the given address on an adapter,
+* or NULL if there is none or it does not acknowledge.
+*
+*******************************************************************************/
+static cy_hpi_master_loopback_t *Cy_HPI_Master_LoopbackFind(CySCB_Type *scbBase, uint8_t slaveAddr)
+{
+    cy_hpi_master_loopback_bus_t *bus = (cy_hpi_master_loopback_bus_t *)scbBase->userData;
+    uint8_t idx;
+
+    if (bus == NULL)
+    {
+        return NULL;
+    }
+
+    for (idx = 0U; idx < bus->slaveCount; idx++)
+    {
+        if ((bus->ptrSlaves[idx].slaveAddr == slaveAddr) && (!bus->ptrSlaves[idx].nack))
+        {
+            return &bus->ptrSlaves[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_LoopbackLocate
+****************************************************************************//**
+*
+* Decodes a register address into a region and an offset, and checks that
+* count bytes starting at the offset stay within the region.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_LoopbackLocate(const uint8_t *reg_addr,
+                                         uint8_t reg_size,
+                                         uint32_t count,
+                                         uint32_t *region,
+                                         uint32_t *offset)
+{
+    uint32_t addr = reg_addr[0];
+
+    if (reg_size > 1U)
+    {
+        addr |= (uint32_t)reg_addr[1] << 8;
+    }
+
+    *region = addr >> 12;
+    *offset = addr & (CY_HPI_MASTER_LOOPBACK_REGION_SIZE - 1U);
+
+    return ((*region < CY_HPI_MASTER_LOOPBACK_REGIONS) &&
+            ((*offset + count) <= CY_HPI_MASTER_LOOPBACK_REGION_SIZE));
+}
+
+void Cy_HPI_Master_LoopbackInit(cy_hpi_master_loopback_t *slave,
+                                uint8_t slaveAddr,
+                                uint8_t portCount,
+                                uint16_t siliconId)
+{
+    (void)memset(slave, 0, sizeof(cy_hpi_master_loopback_t));
+
+    slave->slaveAddr = slaveAddr;
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_DEVICE_MODE] = (uint8_t)(CY_HPI_MASTER_LOOPBACK_FW_MODE |
+        ((((uint32_t)portCount - 1U) << CY_HPI_MASTER_DEV_MODE_PORT_POS) & CY_HPI_MASTER_DEV_MODE_PORT_MASK));
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_SI_ID]      = (uint8_t)(siliconId >> 8);
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_SI_ID + 1U] = (uint8_t)siliconId;
+}
+
+void Cy_HPI_Master_LoopbackAttach(CySCB_Type *scbBase, cy_hpi_master_loopback_bus_t *bus)
+{
+    scbBase->fd       = -1;
+    scbBase->userData = bus;
+}
+
+cy_hpi_master_status_t Cy_HPI_Master_LoopbackPortEvent(cy_hpi_master_loopback_t *slave,
+                                                       uint8_t port,
+                                                       uint8_t eventCode,
+                                                       const uint8_t *data,
+                                                       uint16_t dataLen)
+{
+    uint8_t *resp;
+    uint32_t intrState;
+
+    if ((slave == NULL) || (port > CY_HPI_MASTER_PORT_NUMBER_1) || ((data == NULL) && (dataLen != 0U)) ||
+        ((CY_HPI_MASTER_LOOPBACK_PORT_RESP + CY_HPI_MASTER_LOOPBACK_RESP_HDR_SIZE + (uint32_t)dataLen) >
+         CY_HPI_MASTER_LOOPBACK_REGION_SIZE))
+    {
+        return CY_HPI_MASTER_INVALID_ARGS;
+    }
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+
+    resp    = &slave->regs[port + 1U][CY_HPI_MASTER_LOOPBACK_PORT_RESP];
+    resp[0] = eventCode;
+    resp[1] = 0U;
+    resp[2] = (uint8_t)dataLen;
+    resp[3] = (uint8_t)(dataLen >> 8);
+    if (dataLen != 0U)
+    {
+        (void)memcpy(&resp[CY_HPI_MASTER_LOOPBACK_RESP_HDR_SIZE], data, dataLen);
+    }
+
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_INTR_ADDR] |= (uint8_t)(CY_HPI_MASTER_INTR_REG_CLEAR_PORT0_INT << port);
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return CY_HPI_MASTER_SUCCESS;
+}
+
+void Cy_HPI_Master_LoopbackDevEvent(cy_hpi_master_loopback_t *slave,
+                                    uint8_t eventCode)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_RESPONSE]      = eventCode;
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_RESPONSE + 1U] = 0U;
+    slave->regs[0][CY_HPI_MASTER_DEV_REG_INTR_ADDR]    |= CY_HPI_MASTER_INTR_REG_CLEAR_DEV_INT;
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+bool Cy_HPI_Master_LoopbackIntrAsserted(const cy_hpi_master_loopback_t *slave)
+{
+    return (slave->regs[0][CY_HPI_MASTER_DEV_REG_INTR_ADDR] != 0U);
+}
+
+bool Cy_HPI_Master_LoopbackI2cRead(CySCB_Type *scbBase,
+                                   uint8_t slaveAddr,
+                                   uint8_t *buffer,
+                                   uint32_t count,
+                                   uint8_t *reg_addr,
+                                   uint8_t reg_size,
+                                   cy_stc_scb_i2c_context_t *i2cContext)
+{
+    cy_hpi_master_loopback_t *slave;
+    uint32_t intrState;
+    uint32_t region;
+    uint32_t offset;
+    bool result = false;
+
+    (void)i2cContext;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+
+    slave = Cy_HPI_Master_LoopbackFind(scbBase, slaveAddr);
+    if ((slave != NULL) && (Cy_HPI_Master_LoopbackLocate(reg_addr, reg_size, count, &region, &offset)))
+    {
+        (void)memcpy(buffer, &slave->regs[region][offset], count);
+        slave->readCount++;
+        result = true;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return result;
+}
+
+bool Cy_HPI_Master_LoopbackI2cWrite(CySCB_Type *scbBase,
+                                    uint8_t slaveAddr,
+                                    uint8_t *buffer,
+                                    uint32_t count,
+                                    uint8_t *reg_addr,
+                                    uint8_t reg_size,
+                                    cy_stc_scb_i2c_context_t *i2cContext)
+{
+    cy_hpi_master_loopback_t *slave;
+    uint32_t intrState;
+    uint32_t region;
+    uint32_t offset;
+    uint32_t idx;
+    bool result = false;
+
+    (void)i2cContext;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+
+    slave = Cy_HPI_Master_LoopbackFind(scbBase, slaveAddr);
+    if ((slave != NULL) && (Cy_HPI_Master_LoopbackLocate(reg_addr, reg_size, count, &region, &offset)))
+    {
+        for (idx = 0U; idx < count; idx++)
+        {
+            if ((region == 0U) && ((offset + idx) == CY_HPI_MASTER_DEV_REG_INTR_ADDR))
+            {
+                /* Interrupt Status bits are cleared by writing 1. */
+                slave->regs[0][CY_HPI_MASTER_DEV_REG_INTR_ADDR] &= (uint8_t)~buffer[idx];
+            }
+            else
+            {
+                slave->regs[region][offset + idx] = buffer[idx];
+            }
+        }
+        slave->writeCount++;
+        result = true;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    return result;
+}
+
+bool Cy_HPI_Master_LoopbackI2cWriteRead(CySCB_Type *scbBase,
+                                        uint8_t slaveAddr,
+                                        uint8_t *wrBuffer,
+                                        uint32_t wrCount,
+                                        uint8_t *rdBuffer,
+                                        uint32_t rdCount,
+                                        cy_stc_scb_i2c_context_t *i2cContext)
+{
+    if ((wrCount == 0U) || (wrCount > UINT8_MAX))
+    {
+        return false;
+    }
+
+    return Cy_HPI_Master_LoopbackI2cRead(scbBase, slaveAddr, rdBuffer, rdCount, wrBuffer, (uint8_t)wrCount,
+                                         i2cContext);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,258 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_loopback.h
+* \version 1.1.0
+*
+* Defines the loopback HPI slave devices of the HPI master host build.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_HPI_MASTER_LOOPBACK_H
+#define CY_HPI_MASTER_LOOPBACK_H
+
+#include <stdint.h>
+#include "cy_hpi_master.h"
+
+/**
+********************************************************************************
+* \addtogroup group_hpim_linux
+* \{
+*
+* The loopback backend replaces the I2C adapter by HPI slave devices
+* simulated in memory, so that applications of the HPI master can be tested
+* on the host without hardware. Use \ref Cy_HPI_Master_LoopbackI2cRead and
+* \ref Cy_HPI_Master_LoopbackI2cWrite as the I2C callbacks, and attach the
+* simulated slave devices to the adapter with
+* \ref Cy_HPI_Master_LoopbackAttach.
+*
+* A simulated slave device holds the device register space, the flash
+* memory window and the register space of each port. Writes to the Interrupt
+* Status register clear the written bits, as on a real slave device; all
+* other writes are stored. Events are raised with
+* \ref Cy_HPI_Master_LoopbackPortEvent and \ref Cy_HPI_Master_LoopbackDevEvent,
+* and \ref Cy_HPI_Master_LoopbackIntrAsserted reports the level of the
+* simulated interrupt line.
+*
+********************************************************************************
+* \} */
+
+/**
+* \addtogroup group_hpim_linux
+* \{
+*/
+
+/** Number of 4 KB register regions of a simulated slave device: the device
+ *  region and one region per port. */
+#define CY_HPI_MASTER_LOOPBACK_REGIONS                (3U)
+
+/** Size of a register region in bytes. */
+#define CY_HPI_MASTER_LOOPBACK_REGION_SIZE            (0x1000U)
+
+/**
+* @brief Simulated HPI slave device.
+*/
+typedef struct cy_hpi_master_loopback
+{
+    /** Register regions, indexed by bits 15:12 of the register address. */
+    uint8_t regs[CY_HPI_MASTER_LOOPBACK_REGIONS][CY_HPI_MASTER_LOOPBACK_REGION_SIZE];
+
+    /** Slave I2C address (7 bits). */
+    uint8_t slaveAddr;
+
+    /** Set to make the slave device NACK its address. */
+    bool nack;
+
+    /** Number of read transfers addressed to the slave device. */
+    uint32_t readCount;
+
+    /** Number of write transfers addressed to the slave device. */
+    uint32_t writeCount;
+}cy_hpi_master_loopback_t;
+
+/**
+* @brief Simulated slave devices on one adapter.
+*/
+typedef struct cy_hpi_master_loopback_bus
+{
+    /** Pointer to the slave devices. */
+    cy_hpi_master_loopback_t *ptrSlaves;
+
+    /** Number of slave devices. */
+    uint8_t slaveCount;
+}cy_hpi_master_loopback_bus_t;
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackInit
+****************************************************************************//**
+*
+* Initializes a simulated slave device in FW1 mode, with the given port count
+* and silicon ID in the Device Mode and Silicon ID registers.
+*
+* \param slave
+* Slave device to initialize.
+*
+* \param slaveAddr
+* I2C slave address (7 bits).
+*
+* \param portCount
+* Number of PD ports (1 or 2).
+*
+* \param siliconId
+* Silicon ID.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_LoopbackInit(cy_hpi_master_loopback_t *slave,
+                                uint8_t slaveAddr,
+                                uint8_t portCount,
+                                uint16_t siliconId);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackAttach
+****************************************************************************//**
+*
+* Attaches simulated slave devices to an adapter. The adapter does not need
+* to be opened.
+*
+* \param scbBase
+* Adapter passed as ptrScbBase or as the ptrScbBase member of a bus.
+*
+* \param bus
+* Simulated slave devices. Must stay valid while the adapter is used.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_LoopbackAttach(CySCB_Type *scbBase, cy_hpi_master_loopback_bus_t *bus);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackPortEvent
+****************************************************************************//**
+*
+* Places a port event or response in the response registers of a port and
+* sets the port interrupt.
+*
+* \param slave
+* Simulated slave device.
+*
+* \param port
+* Port number.
+*
+* \param eventCode
+* Event or response code.
+*
+* \param data
+* Event data. Can be NULL if dataLen is 0.
+*
+* \param dataLen
+* Event data length in bytes.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the event is raised.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_LoopbackPortEvent(cy_hpi_master_loopback_t *slave,
+                                                       uint8_t port,
+                                                       uint8_t eventCode,
+                                                       const uint8_t *data,
+                                                       uint16_t dataLen);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackDevEvent
+****************************************************************************//**
+*
+* Places a device event or response in the Response register and sets the
+* device interrupt.
+*
+* \param slave
+* Simulated slave device.
+*
+* \param eventCode
+* Event or response code.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_LoopbackDevEvent(cy_hpi_master_loopback_t *slave,
+                                    uint8_t eventCode);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackIntrAsserted
+****************************************************************************//**
+*
+* Returns the level of the simulated interrupt line.
+*
+* \param slave
+* Simulated slave device.
+*
+* \return
+* true while an interrupt of the slave device is not cleared.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LoopbackIntrAsserted(const cy_hpi_master_loopback_t *slave);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackI2cRead
+****************************************************************************//**
+*
+* I2C read callback (i2c_master_read) of the loopback backend. The
+* parameters are those of \ref Cy_HPI_Master_LinuxI2cRead.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LoopbackI2cRead(CySCB_Type *scbBase,
+                                   uint8_t slaveAddr,
+                                   uint8_t *buffer,
+                                   uint32_t count,
+                                   uint8_t *reg_addr,
+                                   uint8_t reg_size,
+                                   cy_stc_scb_i2c_context_t *i2cContext);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackI2cWrite
+****************************************************************************//**
+*
+* I2C write callback (i2c_master_write) of the loopback backend. The
+* parameters are those of \ref Cy_HPI_Master_LinuxI2cWrite.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LoopbackI2cWrite(CySCB_Type *scbBase,
+                                    uint8_t slaveAddr,
+                                    uint8_t *buffer,
+                                    uint32_t count,
+                                    uint8_t *reg_addr,
+                                    uint8_t reg_size,
+                                    cy_stc_scb_i2c_context_t *i2cContext);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_LoopbackI2cWriteRead
+****************************************************************************//**
+*
+* Combined write-read callback (i2c_master_write_read) of the loopback
+* backend. The write holds the register address. The parameters are those of
+* \ref Cy_HPI_Master_LinuxI2cWriteRead.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_LoopbackI2cWriteRead(CySCB_Type *scbBase,
+                                        uint8_t slaveAddr,
+                                        uint8_t *wrBuffer,
+                                        uint32_t wrCount,
+                                        uint8_t *rdBuffer,
+                                        uint32_t rdCount,
+                                        cy_stc_scb_i2c_context_t *i2cContext);
+
+/** \} group_hpim_linux */
+
+#endif /* CY_HPI_MASTER_LOOPBACK_H */
+
+/* [] END OF FILE */
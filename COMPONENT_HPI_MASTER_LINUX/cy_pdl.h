@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name: cy_pdl.h
+* \version 1.1.0
+*
+* Host replacement for the peripheral driver library definitions used by the
+* HPI master middleware. It allows the HPI master to be built for Linux with
+* the backend in cy_hpi_master_linux.c.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* \addtogroup group_hpim_linux
+* \{
+*/
+
+/** Drive mode set on the SCL and SDA pins by the bus recovery sequence. */
+#define CY_GPIO_DM_OD_DRIVESLOW                       (4UL)
+
+/**
+* @brief I2C adapter of the host, passed to the I2C callbacks as scbBase.
+*/
+typedef struct
+{
+    /** File descriptor of the i2c-dev adapter. -1 if the adapter is not
+        opened. */
+    int fd;
+
+    /** Backend data. The loopback backend keeps its bus here. */
+    void *userData;
+} CySCB_Type;
+
+/**
+* @brief I2C driver context. Not used on the host.
+*/
+typedef struct
+{
+    /** Not used. */
+    uint32_t reserved;
+} cy_stc_scb_i2c_context_t;
+
+/**
+* @brief GPIO port of the host: a GPIO character device line request. The pin
+* number selects the line within the request.
+*/
+typedef struct
+{
+    /** File descriptor of the line request. */
+    int fd;
+} GPIO_PRT_Type;
+
+/**
+* @brief Pin function selection. Pin functions are owned by the kernel on the
+* host, so only the GPIO selection exists.
+*/
+typedef enum
+{
+    HSIOM_SEL_GPIO = 0,                                     /**< GPIO function. */
+} en_hsiom_sel_t;
+
+/** Enters the critical section shared by the HPI master and the backend
+ *  threads. Can be nested. */
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+
+/** Leaves the critical section. */
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+/** Waits for the given number of microseconds. */
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+
+/** Reads a line of a GPIO line request. */
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/** Sets a line of a GPIO line request requested as an output. */
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value);
+
+/** Returns HSIOM_SEL_GPIO. */
+en_hsiom_sel_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/** Does nothing: the line function is set when the line is requested. */
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, en_hsiom_sel_t value);
+
+/** Returns CY_GPIO_DM_OD_DRIVESLOW. */
+uint32_t Cy_GPIO_GetDrivemode(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/** Does nothing: the drive mode is set when the line is requested. */
+void Cy_GPIO_SetDrivemode(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value);
+
+/** \} group_hpim_linux */
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,362 @@
+/*******************************************************************************
+* File Name: cy_hpi_flash_test.c
+* \version 1.1.0
+*
+* Host tests of the HPI slave flash update extension.
+*
+* The tests drive Cy_Hpi_FlashDevWriteHandler and Cy_Hpi_FlashTask as the
+* HPI slave library would, with a non-blocking flash driver whose writes
+* complete when the test calls the registered callback. The responses sent
+* through Cy_Hpi_RegEnqueueEvent are recorded by the test. The tests cover
+* the delayed response of a command received while a row is programmed, the
+* BUSY response while a response is delayed, and a failed row write.
+*
+* Usage: hpiflash_test
+*
+* Prints one line per test and returns 0 if all tests pass.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cy_hpi_flash.h"
+
+/* Flash row size, number of flash rows and last bootloader row. */
+#define CY_HPI_FLASH_TEST_ROW_SIZE                    (128U)
+#define CY_HPI_FLASH_TEST_ROW_COUNT                   (64U)
+#define CY_HPI_FLASH_TEST_BL_LAST_ROW                 (15U)
+
+/* Response code returned by the handler for a command it does not handle. */
+#define CY_HPI_FLASH_TEST_NOT_HANDLED                 (-1)
+
+/* Checks a condition of the current test. */
+#define CY_HPI_FLASH_TEST_CHECK(cond)                 Cy_Hpi_FlashTestCheck((cond), #cond, __LINE__)
+
+/* HPI library state. */
+static cy_stc_hpi_context_t gl_HpiFlashTestContext;
+static cy_stc_hpi_app_cbk_t gl_HpiFlashTestAppCbk;
+static cy_stc_hpi_flash_ctx_t gl_HpiFlashTestFlashCtx;
+
+/* Simulated flash and the write in progress. */
+static uint8_t gl_HpiFlashTestFlash[CY_HPI_FLASH_TEST_ROW_COUNT][CY_HPI_FLASH_TEST_ROW_SIZE];
+static uint8_t gl_HpiFlashTestWriteData[CY_HPI_FLASH_TEST_ROW_SIZE];
+static uint16_t gl_HpiFlashTestWriteRow;
+static uint32_t gl_HpiFlashTestWrites;
+static cy_hpi_flash_write_cbk_t gl_HpiFlashTestWriteCbk;
+
+/* Responses sent through Cy_Hpi_RegEnqueueEvent. */
+static uint8_t gl_HpiFlashTestEvents[8];
+static uint32_t gl_HpiFlashTestEventCount;
+
+/* Number of failed checks in the current test and of failed tests. */
+static uint32_t gl_HpiFlashTestCheckFails;
+static uint32_t gl_HpiFlashTestFails;
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestCheck
+****************************************************************************//**
+*
+* Records and prints a failed check.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestCheck(bool pass, const char *cond, int line)
+{
+    if (!pass)
+    {
+        printf("    line %d: check failed: %s\n", line, cond);
+        gl_HpiFlashTestCheckFails++;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestEnd
+****************************************************************************//**
+*
+* Prints the result of a test.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestEnd(const char *name)
+{
+    printf("%-28s %s\n", name, (gl_HpiFlashTestCheckFails == 0U) ? "PASS" : "FAIL");
+    if (gl_HpiFlashTestCheckFails != 0U)
+    {
+        gl_HpiFlashTestFails++;
+    }
+    gl_HpiFlashTestCheckFails = 0U;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_RegEnqueueEvent
+****************************************************************************//**
+*
+* Replaces the HPI library function: records the response code.
+*
+*******************************************************************************/
+bool Cy_Hpi_RegEnqueueEvent(cy_stc_hpi_context_t *context,
+                            cy_en_hpi_reg_section_t section,
+                            uint8_t status,
+                            uint16_t length,
+                            uint8_t *data)
+{
+    (void)context;
+    (void)length;
+    (void)data;
+
+    if ((section == CY_HPI_REG_SECTION_DEV) &&
+        (gl_HpiFlashTestEventCount < sizeof(gl_HpiFlashTestEvents)))
+    {
+        gl_HpiFlashTestEvents[gl_HpiFlashTestEventCount] = status;
+    }
+    gl_HpiFlashTestEventCount++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestAccess
+****************************************************************************//**
+*
+* hpi_flash_access_get_status callback: the device is in flashing mode.
+*
+*******************************************************************************/
+static bool Cy_Hpi_FlashTestAccess(uint8_t modeflag)
+{
+    return ((modeflag & CY_HPI_FLASH_IF_HPI_MASK) != 0U);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestRowWrite
+****************************************************************************//**
+*
+* hpi_flash_row_write callback: starts a non-blocking write, which is
+* finished by Cy_Hpi_FlashTestWriteDone.
+*
+*******************************************************************************/
+static int8_t Cy_Hpi_FlashTestRowWrite(uint16_t rowNum, uint8_t *data, void *cbk)
+{
+    gl_HpiFlashTestWriteRow = rowNum;
+    (void)memcpy(gl_HpiFlashTestWriteData, data, CY_HPI_FLASH_TEST_ROW_SIZE);
+    (void)memcpy(&gl_HpiFlashTestWriteCbk, &cbk, sizeof(gl_HpiFlashTestWriteCbk));
+    gl_HpiFlashTestWrites++;
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestRowRead
+****************************************************************************//**
+*
+* hpi_flash_row_read callback.
+*
+*******************************************************************************/
+static int8_t Cy_Hpi_FlashTestRowRead(uint16_t rowNum, uint8_t *data)
+{
+    (void)memcpy(data, gl_HpiFlashTestFlash[rowNum], CY_HPI_FLASH_TEST_ROW_SIZE);
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestWriteDone
+****************************************************************************//**
+*
+* Finishes the write in progress with the given status, as the flash driver
+* would from its interrupt handler.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestWriteDone(cy_en_hpi_flash_write_status_t status)
+{
+    cy_hpi_flash_write_cbk_t cbk = gl_HpiFlashTestWriteCbk;
+
+    if (status == CY_HPI_FLASH_WRITE_COMPLETE)
+    {
+        (void)memcpy(gl_HpiFlashTestFlash[gl_HpiFlashTestWriteRow], gl_HpiFlashTestWriteData,
+                     CY_HPI_FLASH_TEST_ROW_SIZE);
+    }
+    gl_HpiFlashTestWriteCbk = NULL;
+    cbk(status);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestFill
+****************************************************************************//**
+*
+* Writes the flash data memory with the fill byte, as the EC does before a
+* row write command.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestFill(uint8_t fill)
+{
+    (void)memset(gl_HpiFlashTestContext.regSpace.flashMem, fill, CY_HPI_FLASH_TEST_ROW_SIZE);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestCmd
+****************************************************************************//**
+*
+* Issues the FLASH_READ_WRITE command for the row. Returns the response code,
+* or CY_HPI_FLASH_TEST_NOT_HANDLED.
+*
+*******************************************************************************/
+static int Cy_Hpi_FlashTestCmd(uint8_t cmd, uint16_t rowNum)
+{
+    uint8_t param[CY_HPI_FLASH_READ_WRITE_CMD_LEN] = {CY_HPI_FLASH_READ_WRITE_CMD_SIG, cmd,
+                                                      (uint8_t)rowNum, (uint8_t)(rowNum >> 8)};
+    cy_en_hpi_status_t stat = CY_HPI_STAT_SUCCESS;
+    cy_en_hpi_response_t code = CY_HPI_RESPONSE_NO_RESPONSE;
+
+    if (!Cy_Hpi_FlashDevWriteHandler(&gl_HpiFlashTestContext, (uint8_t)CY_HPI_DEV_REG_FLASH_READ_WRITE,
+                                     param, (uint8_t)sizeof(param), &stat, &code))
+    {
+        return CY_HPI_FLASH_TEST_NOT_HANDLED;
+    }
+
+    return (int)code;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestSetup
+****************************************************************************//**
+*
+* Resets the simulated flash and initializes the flash update extension.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestSetup(void)
+{
+    (void)memset(gl_HpiFlashTestFlash, 0xFF, sizeof(gl_HpiFlashTestFlash));
+    gl_HpiFlashTestWrites     = 0U;
+    gl_HpiFlashTestWriteCbk   = NULL;
+    gl_HpiFlashTestEventCount = 0U;
+
+    gl_HpiFlashTestAppCbk.hpi_flash_access_get_status = Cy_Hpi_FlashTestAccess;
+    gl_HpiFlashTestAppCbk.hpi_flash_row_write         = Cy_Hpi_FlashTestRowWrite;
+    gl_HpiFlashTestAppCbk.hpi_flash_row_read          = Cy_Hpi_FlashTestRowRead;
+
+    gl_HpiFlashTestContext.ptrAppCbk                = &gl_HpiFlashTestAppCbk;
+    gl_HpiFlashTestContext.flashConfig.flashRowSize = CY_HPI_FLASH_TEST_ROW_SIZE;
+    gl_HpiFlashTestContext.flashConfig.flashRowCnt  = CY_HPI_FLASH_TEST_ROW_COUNT;
+    gl_HpiFlashTestContext.flashConfig.blLastRow    = CY_HPI_FLASH_TEST_BL_LAST_ROW;
+
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashInit(&gl_HpiFlashTestContext, &gl_HpiFlashTestFlashCtx) ==
+                            CY_HPI_STAT_SUCCESS);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestDeferred
+****************************************************************************//**
+*
+* Streams a row while the previous row is programmed, and checks that the
+* response is delayed until the write completes, that a command received
+* meanwhile is answered with BUSY, and that the delayed command is then
+* executed and answered.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestDeferred(void)
+{
+    uint8_t expected[CY_HPI_FLASH_TEST_ROW_SIZE];
+
+    Cy_Hpi_FlashTestSetup();
+
+    Cy_Hpi_FlashTestFill(0xA5U);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 20U) ==
+                            (int)CY_HPI_RESPONSE_SUCCESS);
+    CY_HPI_FLASH_TEST_CHECK((gl_HpiFlashTestWrites == 1U) && (gl_HpiFlashTestWriteRow == 20U));
+    CY_HPI_FLASH_TEST_CHECK(!Cy_Hpi_FlashIsIdle(&gl_HpiFlashTestContext));
+
+    /* Row 20 is programmed: the response to row 21 is delayed. */
+    Cy_Hpi_FlashTestFill(0x5AU);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 21U) ==
+                            (int)CY_HPI_RESPONSE_NO_RESPONSE);
+
+    /* A response is delayed: the next command is not executed, and does not
+     * replace the delayed one. */
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 22U) ==
+                            (int)CY_HPI_FLASH_RESPONSE_BUSY);
+
+    Cy_Hpi_FlashTask(&gl_HpiFlashTestContext);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEventCount == 0U);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestWrites == 1U);
+
+    Cy_Hpi_FlashTestWriteDone(CY_HPI_FLASH_WRITE_COMPLETE);
+    Cy_Hpi_FlashTask(&gl_HpiFlashTestContext);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEventCount == 1U);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEvents[0] == (uint8_t)CY_HPI_RESPONSE_SUCCESS);
+    CY_HPI_FLASH_TEST_CHECK((gl_HpiFlashTestWrites == 2U) && (gl_HpiFlashTestWriteRow == 21U));
+
+    /* Row 21 is written from the flash data memory when the delayed command
+     * is executed, and row 22 is not written. */
+    Cy_Hpi_FlashTestWriteDone(CY_HPI_FLASH_WRITE_COMPLETE);
+    (void)memset(expected, 0xA5U, sizeof(expected));
+    CY_HPI_FLASH_TEST_CHECK(memcmp(gl_HpiFlashTestFlash[20], expected, sizeof(expected)) == 0);
+    (void)memset(expected, 0x5AU, sizeof(expected));
+    CY_HPI_FLASH_TEST_CHECK(memcmp(gl_HpiFlashTestFlash[21], expected, sizeof(expected)) == 0);
+    (void)memset(expected, 0xFFU, sizeof(expected));
+    CY_HPI_FLASH_TEST_CHECK(memcmp(gl_HpiFlashTestFlash[22], expected, sizeof(expected)) == 0);
+
+    Cy_Hpi_FlashTask(&gl_HpiFlashTestContext);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashIsIdle(&gl_HpiFlashTestContext));
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_STREAM_FLUSH_CMD, 0U) ==
+                            (int)CY_HPI_RESPONSE_SUCCESS);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEventCount == 1U);
+
+    Cy_Hpi_FlashTestEnd("flash deferred command");
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTestAborted
+****************************************************************************//**
+*
+* Fails a row write while the next row is delayed, and checks that the
+* delayed row and the flush are answered with FLASH_UPDATE_FAILED, and that
+* the update can restart after the flush.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTestAborted(void)
+{
+    Cy_Hpi_FlashTestSetup();
+
+    Cy_Hpi_FlashTestFill(0x11U);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 30U) ==
+                            (int)CY_HPI_RESPONSE_SUCCESS);
+    Cy_Hpi_FlashTestFill(0x22U);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 31U) ==
+                            (int)CY_HPI_RESPONSE_NO_RESPONSE);
+
+    Cy_Hpi_FlashTestWriteDone(CY_HPI_FLASH_WRITE_ABORTED);
+    Cy_Hpi_FlashTask(&gl_HpiFlashTestContext);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEventCount == 1U);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestEvents[0] == (uint8_t)CY_HPI_RESPONSE_FLASH_UPDATE_FAILED);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestFlashCtx.failedRow == 30U);
+    CY_HPI_FLASH_TEST_CHECK(gl_HpiFlashTestWrites == 1U);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashIsIdle(&gl_HpiFlashTestContext));
+
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_STREAM_FLUSH_CMD, 0U) ==
+                            (int)CY_HPI_RESPONSE_FLASH_UPDATE_FAILED);
+    Cy_Hpi_FlashTestFill(0x11U);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashTestCmd(CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, 30U) ==
+                            (int)CY_HPI_RESPONSE_SUCCESS);
+    CY_HPI_FLASH_TEST_CHECK((gl_HpiFlashTestWrites == 2U) && (gl_HpiFlashTestWriteRow == 30U));
+
+    Cy_Hpi_FlashTestWriteDone(CY_HPI_FLASH_WRITE_COMPLETE);
+    Cy_Hpi_FlashTask(&gl_HpiFlashTestContext);
+    CY_HPI_FLASH_TEST_CHECK(Cy_Hpi_FlashIsIdle(&gl_HpiFlashTestContext));
+
+    Cy_Hpi_FlashTestEnd("flash aborted write");
+}
+
+int main(void)
+{
+    Cy_Hpi_FlashTestDeferred();
+    Cy_Hpi_FlashTestAborted();
+
+    return (gl_HpiFlashTestFails == 0U) ? 0 : 1;
+}
+
+/* [] END OF FILE */
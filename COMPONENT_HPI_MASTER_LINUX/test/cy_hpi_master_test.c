@@ -0,0 +1,615 @@
+/*******************************************************************************
+* File Name: cy_hpi_master_test.c
+* \version 1.1.0
+*
+* Host tests of the HPI master on the loopback slave devices.
+*
+* The tests cover the event queue (wrap around the end of the buffer and the
+* overflow policies), the firmware update engine (success, a failed
+* validation, and a slave device which stops responding) and the group
+* register write. The loopback slave devices do not implement the flash
+* commands, so the I2C write callback of the tests answers the
+* ENTER_FLASH_MODE, FLASH_READ_WRITE and VALIDATE_FW writes with a device
+* response, and stores the written rows.
+*
+* Usage: hpimaster_test
+*
+* Prints one line per test and returns 0 if all tests pass.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cy_hpi_master_loopback.h"
+
+/* Number of simulated slave devices. */
+#define CY_HPI_MASTER_TEST_SLAVES                     (3U)
+
+/* Size of the event queue buffer: four records with 8 bytes of data, and
+ * the byte which the queue keeps free to tell a full queue from an empty one. */
+#define CY_HPI_MASTER_TEST_QUEUE_SIZE                 (53U)
+
+/* Number of bytes held by the event queue when it is full. */
+#define CY_HPI_MASTER_TEST_QUEUE_FULL                 (52U)
+
+/* Event data length of the queue tests. */
+#define CY_HPI_MASTER_TEST_DATA_LEN                   (8U)
+
+/* Asynchronous port event code raised by the queue tests. */
+#define CY_HPI_MASTER_TEST_EVENT                      (0x84U)
+
+/* Maximum number of events recorded by the event handler. */
+#define CY_HPI_MASTER_TEST_MAX_EVENTS                 (16U)
+
+/* Size of the response buffer. */
+#define CY_HPI_MASTER_TEST_RESP_SIZE                  (64U)
+
+/* Number of entries of the asynchronous transaction queue: two per slave
+ * device for the firmware update. */
+#define CY_HPI_MASTER_TEST_XFER_QUEUE_SIZE            (6U)
+
+/* Flash row size and number of image rows of the firmware update tests. */
+#define CY_HPI_MASTER_TEST_ROW_SIZE                   (64U)
+#define CY_HPI_MASTER_TEST_ROW_COUNT                  (5U)
+
+/* First flash row of the image. */
+#define CY_HPI_MASTER_TEST_START_ROW                  (2U)
+
+/* Number of simulated flash rows of a slave device. */
+#define CY_HPI_MASTER_TEST_FLASH_ROWS                 (8U)
+
+/* Flash data memory address of the HPI register space. */
+#define CY_HPI_MASTER_TEST_FLASH_MEM                  (0x0200U)
+
+/* Largest number of Cy_HPI_Master_Task calls a firmware update may take. */
+#define CY_HPI_MASTER_TEST_MAX_ITERATIONS             (200U)
+
+/* Checks a condition of the current test. */
+#define CY_HPI_MASTER_TEST_CHECK(cond)                Cy_HPI_Master_TestCheck((cond), #cond, __LINE__)
+
+/* Behaviour of a simulated slave device during the firmware update. */
+typedef enum
+{
+    CY_HPI_MASTER_TEST_FWU_OK = 0,                          /* Responds with success. */
+    CY_HPI_MASTER_TEST_FWU_INVALID_FW,                      /* Fails the validation. */
+    CY_HPI_MASTER_TEST_FWU_SILENT                           /* Stops responding after the first row. */
+} cy_en_hpi_master_test_fwu_t;
+
+/* Slave addresses and number of ports of the simulated slave devices. */
+static const uint8_t gl_HpiMasterTestAddrs[CY_HPI_MASTER_TEST_SLAVES] = {0x40U, 0x42U, 0x08U};
+static const uint8_t gl_HpiMasterTestPorts[CY_HPI_MASTER_TEST_SLAVES] = {2U, 2U, 1U};
+
+/* Simulated slave devices and their flash. */
+static cy_hpi_master_loopback_t gl_HpiMasterTestDevs[CY_HPI_MASTER_TEST_SLAVES];
+static uint8_t gl_HpiMasterTestFlash[CY_HPI_MASTER_TEST_SLAVES][CY_HPI_MASTER_TEST_FLASH_ROWS]
+                                    [CY_HPI_MASTER_TEST_ROW_SIZE];
+static cy_en_hpi_master_test_fwu_t gl_HpiMasterTestFwu[CY_HPI_MASTER_TEST_SLAVES];
+
+/* Library buffers. */
+static cy_hpi_master_slave_dev_t gl_HpiMasterTestSlaves[CY_HPI_MASTER_TEST_SLAVES];
+static uint8_t gl_HpiMasterTestQueueBuf[CY_HPI_MASTER_TEST_QUEUE_SIZE];
+static uint8_t gl_HpiMasterTestResp[CY_HPI_MASTER_TEST_RESP_SIZE];
+static cy_hpi_master_xfer_t gl_HpiMasterTestXfers[CY_HPI_MASTER_TEST_XFER_QUEUE_SIZE];
+
+/* Adapter of the simulated slave devices. */
+static CySCB_Type gl_HpiMasterTestAdapter;
+static cy_stc_scb_i2c_context_t gl_HpiMasterTestI2c;
+static cy_hpi_master_loopback_bus_t gl_HpiMasterTestBus = {gl_HpiMasterTestDevs, CY_HPI_MASTER_TEST_SLAVES};
+
+/* First data byte of each delivered event, in delivery order. */
+static uint8_t gl_HpiMasterTestEvents[CY_HPI_MASTER_TEST_MAX_EVENTS];
+static uint32_t gl_HpiMasterTestEventCount;
+
+/* Number of CY_HPI_MASTER_QUEUE_OVERFLOW errors reported. */
+static uint32_t gl_HpiMasterTestOverflows;
+
+/* Number of failed checks in the current test and of failed tests. */
+static uint32_t gl_HpiMasterTestCheckFails;
+static uint32_t gl_HpiMasterTestFails;
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestCheck
+****************************************************************************//**
+*
+* Records and prints a failed check.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestCheck(bool pass, const char *cond, int line)
+{
+    if (!pass)
+    {
+        printf("    line %d: check failed: %s\n", line, cond);
+        gl_HpiMasterTestCheckFails++;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestEnd
+****************************************************************************//**
+*
+* Prints the result of a test.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestEnd(const char *name)
+{
+    printf("%-28s %s\n", name, (gl_HpiMasterTestCheckFails == 0U) ? "PASS" : "FAIL");
+    if (gl_HpiMasterTestCheckFails != 0U)
+    {
+        gl_HpiMasterTestFails++;
+    }
+    gl_HpiMasterTestCheckFails = 0U;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestEventHandler
+****************************************************************************//**
+*
+* Event handler: records the first data byte of each event.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_TestEventHandler(struct cy_hpi_master_context *context, cy_hpi_master_event_t *event)
+{
+    (void)context;
+
+    if ((gl_HpiMasterTestEventCount < CY_HPI_MASTER_TEST_MAX_EVENTS) && (event->dataLen != 0U))
+    {
+        gl_HpiMasterTestEvents[gl_HpiMasterTestEventCount] = event->eventData[0];
+    }
+    gl_HpiMasterTestEventCount++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestErrorHandler
+****************************************************************************//**
+*
+* Error handler: counts the event queue overflows.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_TestErrorHandler(struct cy_hpi_master_context *context, cy_hpi_master_event_t *event)
+{
+    (void)context;
+
+    if (event->eventCode == (uint8_t)CY_HPI_MASTER_QUEUE_OVERFLOW)
+    {
+        gl_HpiMasterTestOverflows++;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestI2cWrite
+****************************************************************************//**
+*
+* I2C write callback: writes the loopback slave device and answers the
+* firmware update commands as configured in gl_HpiMasterTestFwu.
+*
+*******************************************************************************/
+static bool Cy_HPI_Master_TestI2cWrite(CySCB_Type *scbBase,
+                                       uint8_t slaveAddr,
+                                       uint8_t *buffer,
+                                       uint32_t count,
+                                       uint8_t *reg_addr,
+                                       uint8_t reg_size,
+                                       cy_stc_scb_i2c_context_t *i2cContext)
+{
+    cy_hpi_master_loopback_t *dev = NULL;
+    uint16_t regAddress;
+    uint16_t row;
+    uint32_t idx;
+
+    if (!Cy_HPI_Master_LoopbackI2cWrite(scbBase, slaveAddr, buffer, count, reg_addr, reg_size, i2cContext))
+    {
+        return false;
+    }
+
+    for (idx = 0U; idx < CY_HPI_MASTER_TEST_SLAVES; idx++)
+    {
+        if (gl_HpiMasterTestDevs[idx].slaveAddr == slaveAddr)
+        {
+            dev = &gl_HpiMasterTestDevs[idx];
+            break;
+        }
+    }
+
+    regAddress = (uint16_t)reg_addr[0] | ((uint16_t)reg_addr[1] << 8);
+
+    if (regAddress == (uint16_t)CY_HPI_MASTER_DEV_REG_ENTER_FLASH_MODE)
+    {
+        Cy_HPI_Master_LoopbackDevEvent(dev, (uint8_t)CY_HPI_MASTER_RESPONSE_SUCCESS);
+    }
+    else if (regAddress == (uint16_t)CY_HPI_MASTER_DEV_REG_FLASH_READ_WRITE)
+    {
+        row = (uint16_t)buffer[2] | ((uint16_t)buffer[3] << 8);
+        if (row < CY_HPI_MASTER_TEST_FLASH_ROWS)
+        {
+            (void)memcpy(gl_HpiMasterTestFlash[idx][row], &dev->regs[0][CY_HPI_MASTER_TEST_FLASH_MEM],
+                         CY_HPI_MASTER_TEST_ROW_SIZE);
+        }
+        if ((gl_HpiMasterTestFwu[idx] != CY_HPI_MASTER_TEST_FWU_SILENT) ||
+            (row == CY_HPI_MASTER_TEST_START_ROW))
+        {
+            Cy_HPI_Master_LoopbackDevEvent(dev, (uint8_t)CY_HPI_MASTER_RESPONSE_SUCCESS);
+        }
+    }
+    else if (regAddress == (uint16_t)CY_HPI_MASTER_DEV_REG_VALIDATE_FW_ADDR)
+    {
+        Cy_HPI_Master_LoopbackDevEvent(dev, (gl_HpiMasterTestFwu[idx] == CY_HPI_MASTER_TEST_FWU_INVALID_FW) ?
+                                            (uint8_t)CY_HPI_MASTER_RESPONSE_INVALID_FW :
+                                            (uint8_t)CY_HPI_MASTER_RESPONSE_SUCCESS);
+    }
+    else
+    {
+        /* Other registers are only stored. */
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestSetup
+****************************************************************************//**
+*
+* Resets the simulated slave devices and the test state, and initializes the
+* library with the slave devices registered. Returns the initialization
+* status.
+*
+*******************************************************************************/
+static cy_hpi_master_status_t Cy_HPI_Master_TestSetup(cy_hpi_master_context_t *context,
+                                                      cy_hpi_master_app_cbk_t *appCbk)
+{
+    cy_hpi_master_status_t status;
+    uint32_t idx;
+
+    (void)memset(gl_HpiMasterTestFlash, 0, sizeof(gl_HpiMasterTestFlash));
+    (void)memset(gl_HpiMasterTestQueueBuf, 0, sizeof(gl_HpiMasterTestQueueBuf));
+    gl_HpiMasterTestEventCount = 0U;
+    gl_HpiMasterTestOverflows  = 0U;
+
+    for (idx = 0U; idx < CY_HPI_MASTER_TEST_SLAVES; idx++)
+    {
+        Cy_HPI_Master_LoopbackInit(&gl_HpiMasterTestDevs[idx], gl_HpiMasterTestAddrs[idx],
+                                   gl_HpiMasterTestPorts[idx], 0x3010U);
+    }
+    Cy_HPI_Master_LoopbackAttach(&gl_HpiMasterTestAdapter, &gl_HpiMasterTestBus);
+
+    appCbk->i2c_master_read  = Cy_HPI_Master_LoopbackI2cRead;
+    appCbk->i2c_master_write = Cy_HPI_Master_TestI2cWrite;
+    appCbk->event_handler    = Cy_HPI_Master_TestEventHandler;
+    appCbk->error_handler    = Cy_HPI_Master_TestErrorHandler;
+
+    status = Cy_HPI_Master_Init(context, appCbk);
+    for (idx = 0U; (status == CY_HPI_MASTER_SUCCESS) && (idx < CY_HPI_MASTER_TEST_SLAVES); idx++)
+    {
+        gl_HpiMasterTestFwu[idx] = CY_HPI_MASTER_TEST_FWU_OK;
+        status = Cy_HPI_Master_SlaveDeviceInit(context, gl_HpiMasterTestDevs[idx].slaveAddr, 0U, (uint8_t)idx,
+                                               gl_HpiMasterTestPorts[idx]);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestRun
+****************************************************************************//**
+*
+* Passes the asserted interrupt lines of the simulated slave devices to the
+* library and runs Cy_HPI_Master_Task, with one poll timer tick per call.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestRun(cy_hpi_master_context_t *context, uint32_t calls)
+{
+    uint32_t idx;
+
+    while (calls != 0U)
+    {
+        for (idx = 0U; idx < CY_HPI_MASTER_TEST_SLAVES; idx++)
+        {
+            if (Cy_HPI_Master_LoopbackIntrAsserted(&gl_HpiMasterTestDevs[idx]))
+            {
+                Cy_HPI_Master_SlaveInterruptHandler(context, (uint8_t)idx);
+            }
+        }
+        Cy_HPI_Master_PollTimerHandler(context, 1U);
+        Cy_HPI_Master_Task(context);
+        calls--;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestQueueEvent
+****************************************************************************//**
+*
+* Raises a port event with the given first data byte on slave device 0 and
+* services it. The slave interrupt is pending during the Cy_HPI_Master_Task
+* call, so the event is queued and not dispatched.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestQueueEvent(cy_hpi_master_context_t *context, uint8_t seq)
+{
+    uint8_t data[CY_HPI_MASTER_TEST_DATA_LEN] = {0U};
+
+    data[0] = seq;
+    (void)Cy_HPI_Master_LoopbackPortEvent(&gl_HpiMasterTestDevs[0], CY_HPI_MASTER_PORT_NUMBER_0,
+                                          CY_HPI_MASTER_TEST_EVENT, data, CY_HPI_MASTER_TEST_DATA_LEN);
+    Cy_HPI_Master_SlaveInterruptHandler(context, 0U);
+    Cy_HPI_Master_Task(context);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestDispatch
+****************************************************************************//**
+*
+* Dispatches up to count queued events, one per Cy_HPI_Master_Task call.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestDispatch(cy_hpi_master_context_t *context, uint32_t count)
+{
+    while (count != 0U)
+    {
+        Cy_HPI_Master_Task(context);
+        count--;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestQueueWrap
+****************************************************************************//**
+*
+* Queues events past the end of the queue buffer after the oldest events are
+* dispatched, and checks that the records wrap to the start of the buffer
+* and are delivered in order without loss.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestQueueWrap(void)
+{
+    static const uint8_t expected[] = {0U, 1U, 2U, 3U, 4U};
+    cy_hpi_master_event_queue_t queue = {.startAddress = gl_HpiMasterTestQueueBuf,
+                                         .bufferSize = CY_HPI_MASTER_TEST_QUEUE_SIZE};
+    cy_hpi_master_context_t context = {.ptrEventQueue = &queue, .maxSlaveDevices = CY_HPI_MASTER_TEST_SLAVES,
+                                       .ptrSlaves = gl_HpiMasterTestSlaves, .ptrScbBase = &gl_HpiMasterTestAdapter,
+                                       .ptrI2cContext = &gl_HpiMasterTestI2c,
+                                       .respBuffLen = CY_HPI_MASTER_TEST_RESP_SIZE,
+                                       .ptrRespBuff = gl_HpiMasterTestResp};
+    cy_hpi_master_app_cbk_t appCbk = {0};
+    uint8_t seq;
+
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_TestSetup(&context, &appCbk) == CY_HPI_MASTER_SUCCESS);
+
+    for (seq = 0U; seq < 3U; seq++)
+    {
+        Cy_HPI_Master_TestQueueEvent(&context, seq);
+    }
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestEventCount == 0U);
+
+    Cy_HPI_Master_TestDispatch(&context, 2U);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestEventCount == 2U);
+
+    /* Event 3 fills the end of the buffer, event 4 wraps to its start. */
+    for (seq = 3U; seq < 5U; seq++)
+    {
+        Cy_HPI_Master_TestQueueEvent(&context, seq);
+    }
+    CY_HPI_MASTER_TEST_CHECK(queue.tailIdx < queue.headIdx);
+
+    Cy_HPI_Master_TestDispatch(&context, 6U);
+
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestEventCount == sizeof(expected));
+    CY_HPI_MASTER_TEST_CHECK(memcmp(gl_HpiMasterTestEvents, expected, sizeof(expected)) == 0);
+    CY_HPI_MASTER_TEST_CHECK(queue.stats.enqueued == sizeof(expected));
+    CY_HPI_MASTER_TEST_CHECK(queue.stats.dropped == 0U);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestOverflows == 0U);
+
+    Cy_HPI_Master_TestEnd("queue wrap");
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestQueueOverflow
+****************************************************************************//**
+*
+* Queues one event more than the queue holds with the given overflow policy,
+* and checks the delivered events and the statistics. With
+* CY_HPI_MASTER_QUEUE_DROP_OLDEST, the new record does not fit at the end of
+* the buffer, so the two oldest events are dropped to make room at its start.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestQueueOverflow(const char *name,
+                                            uint8_t policy,
+                                            const uint8_t *expected,
+                                            uint32_t delivered,
+                                            uint32_t dropped,
+                                            uint32_t coalesced)
+{
+    cy_hpi_master_event_queue_t queue = {.startAddress = gl_HpiMasterTestQueueBuf,
+                                         .bufferSize = CY_HPI_MASTER_TEST_QUEUE_SIZE};
+    cy_hpi_master_context_t context = {.ptrEventQueue = &queue, .maxSlaveDevices = CY_HPI_MASTER_TEST_SLAVES,
+                                       .ptrSlaves = gl_HpiMasterTestSlaves, .ptrScbBase = &gl_HpiMasterTestAdapter,
+                                       .ptrI2cContext = &gl_HpiMasterTestI2c,
+                                       .respBuffLen = CY_HPI_MASTER_TEST_RESP_SIZE,
+                                       .ptrRespBuff = gl_HpiMasterTestResp};
+    cy_hpi_master_app_cbk_t appCbk = {0};
+    uint8_t seq;
+
+    queue.overflowPolicy = policy;
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_TestSetup(&context, &appCbk) == CY_HPI_MASTER_SUCCESS);
+
+    for (seq = 0U; seq < 5U; seq++)
+    {
+        Cy_HPI_Master_TestQueueEvent(&context, seq);
+    }
+    Cy_HPI_Master_TestDispatch(&context, 5U);
+
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestEventCount == delivered);
+    CY_HPI_MASTER_TEST_CHECK(memcmp(gl_HpiMasterTestEvents, expected, delivered) == 0);
+    CY_HPI_MASTER_TEST_CHECK(queue.stats.dropped == dropped);
+    CY_HPI_MASTER_TEST_CHECK(queue.stats.coalesced == coalesced);
+    CY_HPI_MASTER_TEST_CHECK(queue.stats.highWatermark == CY_HPI_MASTER_TEST_QUEUE_FULL);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestOverflows ==
+                             ((policy == CY_HPI_MASTER_QUEUE_DROP_OLDEST) ? 0U : dropped));
+
+    Cy_HPI_Master_TestEnd(name);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestFwUpdate
+****************************************************************************//**
+*
+* Updates the three slave devices with one image, the slave device 1
+* behaving as given, with a timeout of timeout ticks. Checks that the update
+* ends, that slave devices 0 and 2 hold the image, and that slave device 1
+* ends in the given state and status.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestFwUpdate(const char *name,
+                                       cy_en_hpi_master_test_fwu_t behaviour,
+                                       uint16_t timeout,
+                                       uint8_t state,
+                                       cy_hpi_master_status_t status)
+{
+    static uint8_t image[CY_HPI_MASTER_TEST_ROW_COUNT * CY_HPI_MASTER_TEST_ROW_SIZE];
+    cy_hpi_master_event_queue_t queue = {.startAddress = gl_HpiMasterTestQueueBuf,
+                                         .bufferSize = CY_HPI_MASTER_TEST_QUEUE_SIZE};
+    cy_hpi_master_context_t context = {.ptrEventQueue = &queue, .maxSlaveDevices = CY_HPI_MASTER_TEST_SLAVES,
+                                       .ptrSlaves = gl_HpiMasterTestSlaves, .ptrScbBase = &gl_HpiMasterTestAdapter,
+                                       .ptrI2cContext = &gl_HpiMasterTestI2c,
+                                       .respBuffLen = CY_HPI_MASTER_TEST_RESP_SIZE,
+                                       .ptrRespBuff = gl_HpiMasterTestResp,
+                                       .ptrXferQueue = gl_HpiMasterTestXfers,
+                                       .xferQueueSize = CY_HPI_MASTER_TEST_XFER_QUEUE_SIZE};
+    cy_hpi_master_app_cbk_t appCbk = {0};
+    cy_hpi_master_fwu_slave_t fwuSlaves[CY_HPI_MASTER_TEST_SLAVES] = {{.slaveIdx = 0U}, {.slaveIdx = 1U},
+                                                                       {.slaveIdx = 2U}};
+    cy_hpi_master_fw_update_t fwUpdate = {0};
+    uint32_t calls = 0U;
+    uint32_t idx;
+    uint32_t row;
+
+    for (idx = 0U; idx < sizeof(image); idx++)
+    {
+        image[idx] = (uint8_t)((idx * 7U) + 1U);
+    }
+
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_TestSetup(&context, &appCbk) == CY_HPI_MASTER_SUCCESS);
+    gl_HpiMasterTestFwu[1] = behaviour;
+
+    fwUpdate.ptrImage   = image;
+    fwUpdate.rowSize    = CY_HPI_MASTER_TEST_ROW_SIZE;
+    fwUpdate.startRow   = CY_HPI_MASTER_TEST_START_ROW;
+    fwUpdate.rowCount   = CY_HPI_MASTER_TEST_ROW_COUNT;
+    fwUpdate.fwMode     = 1U;
+    fwUpdate.ptrSlaves  = fwuSlaves;
+    fwUpdate.slaveCount = CY_HPI_MASTER_TEST_SLAVES;
+    fwUpdate.timeout    = timeout;
+
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_FwUpdateStart(&context, &fwUpdate) == CY_HPI_MASTER_SUCCESS);
+    while ((!Cy_HPI_Master_FwUpdateIdle(&context)) && (calls < CY_HPI_MASTER_TEST_MAX_ITERATIONS))
+    {
+        Cy_HPI_Master_TestRun(&context, 1U);
+        calls++;
+    }
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_FwUpdateIdle(&context));
+
+    for (idx = 0U; idx < CY_HPI_MASTER_TEST_SLAVES; idx += 2U)
+    {
+        CY_HPI_MASTER_TEST_CHECK(fwuSlaves[idx].state == CY_HPI_MASTER_FWU_STATE_DONE);
+        CY_HPI_MASTER_TEST_CHECK(fwuSlaves[idx].status == CY_HPI_MASTER_SUCCESS);
+        CY_HPI_MASTER_TEST_CHECK(fwuSlaves[idx].rowsDone == CY_HPI_MASTER_TEST_ROW_COUNT);
+        for (row = 0U; row < CY_HPI_MASTER_TEST_ROW_COUNT; row++)
+        {
+            CY_HPI_MASTER_TEST_CHECK(memcmp(gl_HpiMasterTestFlash[idx][CY_HPI_MASTER_TEST_START_ROW + row],
+                                            &image[row * CY_HPI_MASTER_TEST_ROW_SIZE],
+                                            CY_HPI_MASTER_TEST_ROW_SIZE) == 0);
+        }
+    }
+
+    CY_HPI_MASTER_TEST_CHECK(fwuSlaves[1].state == state);
+    CY_HPI_MASTER_TEST_CHECK(fwuSlaves[1].status == status);
+    if (behaviour == CY_HPI_MASTER_TEST_FWU_INVALID_FW)
+    {
+        CY_HPI_MASTER_TEST_CHECK(fwuSlaves[1].response == (uint8_t)CY_HPI_MASTER_RESPONSE_INVALID_FW);
+    }
+    if (behaviour == CY_HPI_MASTER_TEST_FWU_SILENT)
+    {
+        CY_HPI_MASTER_TEST_CHECK(fwuSlaves[1].rowsDone == 1U);
+    }
+
+    /* The device responses of the update are not passed to the event
+     * handler. */
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestEventCount == 0U);
+
+    Cy_HPI_Master_TestEnd(name);
+}
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_TestGroupWrite
+****************************************************************************//**
+*
+* Writes a register of all slave devices while slave device 1 does not
+* acknowledge, and checks the per-slave status and the written registers.
+*
+*******************************************************************************/
+static void Cy_HPI_Master_TestGroupWrite(void)
+{
+    cy_hpi_master_event_queue_t queue = {.startAddress = gl_HpiMasterTestQueueBuf,
+                                         .bufferSize = CY_HPI_MASTER_TEST_QUEUE_SIZE};
+    cy_hpi_master_context_t context = {.ptrEventQueue = &queue, .maxSlaveDevices = CY_HPI_MASTER_TEST_SLAVES,
+                                       .ptrSlaves = gl_HpiMasterTestSlaves, .ptrScbBase = &gl_HpiMasterTestAdapter,
+                                       .ptrI2cContext = &gl_HpiMasterTestI2c,
+                                       .respBuffLen = CY_HPI_MASTER_TEST_RESP_SIZE,
+                                       .ptrRespBuff = gl_HpiMasterTestResp,
+                                       .ptrXferQueue = gl_HpiMasterTestXfers,
+                                       .xferQueueSize = CY_HPI_MASTER_TEST_XFER_QUEUE_SIZE};
+    cy_hpi_master_app_cbk_t appCbk = {0};
+    cy_hpi_master_status_t slaveStatus[CY_HPI_MASTER_TEST_SLAVES];
+    uint8_t value = 0x5AU;
+
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_TestSetup(&context, &appCbk) == CY_HPI_MASTER_SUCCESS);
+    gl_HpiMasterTestDevs[1].nack = true;
+
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_GroupWrite(&context, NULL, 0U, 0x1008U, &value, 1U, slaveStatus) ==
+                             CY_HPI_MASTER_FAILURE);
+    CY_HPI_MASTER_TEST_CHECK(slaveStatus[0] == CY_HPI_MASTER_SUCCESS);
+    CY_HPI_MASTER_TEST_CHECK(slaveStatus[1] == CY_HPI_MASTER_I2C_FAILURE);
+    CY_HPI_MASTER_TEST_CHECK(slaveStatus[2] == CY_HPI_MASTER_SUCCESS);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestDevs[0].regs[1][0x008] == value);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestDevs[1].regs[1][0x008] != value);
+    CY_HPI_MASTER_TEST_CHECK(gl_HpiMasterTestDevs[2].regs[1][0x008] == value);
+    CY_HPI_MASTER_TEST_CHECK(Cy_HPI_Master_XferIdle(&context));
+
+    Cy_HPI_Master_TestEnd("group write");
+}
+
+int main(void)
+{
+    static const uint8_t dropNewest[] = {0U, 1U, 2U, 3U};
+    static const uint8_t dropOldest[] = {2U, 3U, 4U};
+    static const uint8_t coalesce[]   = {0U, 1U, 2U, 4U};
+
+    Cy_HPI_Master_TestQueueWrap();
+    Cy_HPI_Master_TestQueueOverflow("queue overflow drop newest", CY_HPI_MASTER_QUEUE_DROP_NEWEST,
+                                    dropNewest, sizeof(dropNewest), 1U, 0U);
+    Cy_HPI_Master_TestQueueOverflow("queue overflow drop oldest", CY_HPI_MASTER_QUEUE_DROP_OLDEST,
+                                    dropOldest, sizeof(dropOldest), 2U, 0U);
+    Cy_HPI_Master_TestQueueOverflow("queue overflow coalesce", CY_HPI_MASTER_QUEUE_COALESCE,
+                                    coalesce, sizeof(coalesce), 0U, 1U);
+    Cy_HPI_Master_TestFwUpdate("fw update success", CY_HPI_MASTER_TEST_FWU_OK, 0U,
+                               CY_HPI_MASTER_FWU_STATE_DONE, CY_HPI_MASTER_SUCCESS);
+    Cy_HPI_Master_TestFwUpdate("fw update invalid fw", CY_HPI_MASTER_TEST_FWU_INVALID_FW, 0U,
+                               CY_HPI_MASTER_FWU_STATE_FAILED, CY_HPI_MASTER_FAILURE);
+    Cy_HPI_Master_TestFwUpdate("fw update timeout", CY_HPI_MASTER_TEST_FWU_SILENT, 10U,
+                               CY_HPI_MASTER_FWU_STATE_FAILED, CY_HPI_MASTER_TIMEOUT);
+    Cy_HPI_Master_TestGroupWrite();
+
+    return (gl_HpiMasterTestFails == 0U) ? 0 : 1;
+}
+
+/* [] END OF FILE */
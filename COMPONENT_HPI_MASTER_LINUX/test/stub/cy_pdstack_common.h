@@ -0,0 +1,50 @@
+/*******************************************************************************
+* File Name: cy_pdstack_common.h
+* \version 1.1.0
+*
+* Host replacement of the PDStack common header, with the types and macros
+* used by the HPI slave headers. Used only to build the flash update
+* extension for the host tests.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_PDSTACK_COMMON_H
+#define CY_PDSTACK_COMMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Retained SRAM is ordinary SRAM on the host. */
+#define CY_NOINIT
+
+/* Maximum number of data objects in a PD message. */
+#define CY_PD_MAX_NO_OF_DO                            (7U)
+
+typedef int cy_en_pdstack_status_t;
+typedef int cy_en_pdstack_dpm_pd_cmd_t;
+typedef int cy_en_pdstack_dpm_typec_cmd_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} cy_stc_pdstack_dpm_pd_cmd_buf_t;
+
+typedef struct
+{
+    uint32_t reserved;
+} cy_stc_pd_packet_extd_t;
+
+typedef struct cy_stc_pdstack_context cy_stc_pdstack_context_t;
+
+typedef void (*cy_pdstack_dpm_typec_cmd_cbk_t)(cy_stc_pdstack_context_t *ptrPdStackContext, int resp);
+
+#endif /* CY_PDSTACK_COMMON_H */
+
+/* [] END OF FILE */
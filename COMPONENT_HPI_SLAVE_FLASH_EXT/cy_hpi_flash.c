@@ -0,0 +1,956 @@
+/***************************************************************************//**
+* \file cy_hpi_flash.c
+* \version 1.1.0
+*
+* Implements the HPI flash update extensions.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "cy_hpi_flash.h"
+
+#if ((CY_HPI_FLASH_EXT_ENABLE) && ((SROM_CODE_HPISS_HPI == MODULE_IN_ROM) || (CY_HPI_FLASH_RW_ENABLE)))
+
+/* Flash update extension context. The flash write completion callback does
+ * not take a context parameter, so a reference is kept here. */
+static cy_stc_hpi_flash_ctx_t *gl_HpiFlashCtx = NULL;
+
+/* Image transfer progress journal. Not initialized at start-up, so that it is
+ * retained across soft reset. */
+static CY_NOINIT cy_stc_hpi_flash_journal_t gl_HpiFlashJournal;
+
+/* CRC-32 (IEEE 802.3, reflected) lookup table for 4-bit nibbles. */
+static const uint32_t gl_HpiFlashCrcTable[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashCrc32
+****************************************************************************//**
+*
+* Updates a CRC-32 value with the given data. Start with 0xFFFFFFFF and invert
+* the final value.
+*
+*******************************************************************************/
+static uint32_t Cy_Hpi_FlashCrc32(uint32_t crc, const uint8_t *data, uint16_t len)
+{
+    uint16_t idx;
+
+    for (idx = 0U; idx < len; idx++)
+    {
+        crc ^= data[idx];
+        crc = (crc >> 4) ^ gl_HpiFlashCrcTable[crc & 0x0FU];
+        crc = (crc >> 4) ^ gl_HpiFlashCrcTable[crc & 0x0FU];
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashJournalCheck
+****************************************************************************//**
+*
+* Returns the check value of the progress journal.
+*
+*******************************************************************************/
+static uint32_t Cy_Hpi_FlashJournalCheck(const cy_stc_hpi_flash_journal_t *journal)
+{
+    return ~Cy_Hpi_FlashCrc32(0xFFFFFFFFU, (const uint8_t *)journal,
+                              (uint16_t)offsetof(cy_stc_hpi_flash_journal_t, check));
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashJournalUpdate
+****************************************************************************//**
+*
+* Records the image tracking progress in the journal, or clears the journal
+* if no image is being tracked.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashJournalUpdate(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    cy_stc_hpi_flash_journal_t *journal = &gl_HpiFlashJournal;
+
+    if (flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE)
+    {
+        journal->magic    = CY_HPI_FLASH_JOURNAL_MAGIC;
+        journal->startRow = flashCtx->imageStartRow;
+        journal->endRow   = flashCtx->imageEndRow;
+        journal->nextRow  = flashCtx->imageDoneRow;
+        journal->fwMode   = flashCtx->imageFwMode;
+        journal->reserved = 0U;
+        journal->crc      = flashCtx->imageDoneCrc;
+        journal->check    = Cy_Hpi_FlashJournalCheck(journal);
+    }
+    else
+    {
+        journal->magic = 0U;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashJournalRestore
+****************************************************************************//**
+*
+* Restores the image tracking state from a valid progress journal.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashJournalRestore(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    const cy_stc_hpi_flash_journal_t *journal = &gl_HpiFlashJournal;
+
+    if ((journal->magic == CY_HPI_FLASH_JOURNAL_MAGIC) &&
+        (journal->check == Cy_Hpi_FlashJournalCheck(journal)) &&
+        (journal->startRow <= journal->nextRow) && (journal->nextRow <= journal->endRow))
+    {
+        flashCtx->imageStartRow = journal->startRow;
+        flashCtx->imageEndRow   = journal->endRow;
+        flashCtx->imageNextRow  = journal->nextRow;
+        flashCtx->imageCrc      = journal->crc;
+        flashCtx->imageDoneRow  = journal->nextRow;
+        flashCtx->imageDoneCrc  = journal->crc;
+        flashCtx->imageFwMode   = journal->fwMode;
+        flashCtx->imageState    = CY_HPI_FLASH_IMAGE_ACTIVE;
+    }
+    else
+    {
+        gl_HpiFlashJournal.magic = 0U;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowData
+****************************************************************************//**
+*
+* Returns the row data area of the flash row staging buffer.
+*
+*******************************************************************************/
+static uint8_t *Cy_Hpi_FlashRowData(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    return ((uint8_t *)flashCtx->rowBuf + CY_SROM_API_PARAM_SIZE);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowSize
+****************************************************************************//**
+*
+* Returns the flash row size configured through Cy_Hpi_SetFlashParams.
+*
+*******************************************************************************/
+static uint16_t Cy_Hpi_FlashRowSize(cy_stc_hpi_context_t *context)
+{
+    uint16_t rowSize = context->flashConfig.flashRowSize;
+
+    if ((rowSize == 0U) || (rowSize > CY_HPI_MAX_FLASH_ROW_SIZE))
+    {
+        rowSize = CY_HPI_MAX_FLASH_ROW_SIZE;
+    }
+
+    return rowSize;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashWriteCbk
+****************************************************************************//**
+*
+* Non-blocking flash write completion callback. Called from the flash driver
+* interrupt context; the result is processed by Cy_Hpi_FlashTask.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashWriteCbk(cy_en_hpi_flash_write_status_t status)
+{
+    cy_stc_hpi_flash_ctx_t *flashCtx = gl_HpiFlashCtx;
+
+    if ((flashCtx != NULL) && (status != CY_HPI_FLASH_WRITE_IN_PROGRESS))
+    {
+        flashCtx->writeStatus = status;
+        flashCtx->writeDone   = true;
+        flashCtx->writeBusy   = false;
+    }
+}
+
+/* The callback is passed to hpi_flash_row_write as a void pointer, which
+ * needs a function pointer to have the size of a void pointer. */
+typedef char cy_hpi_flash_cbk_size_check_t[(sizeof(cy_hpi_flash_write_cbk_t) == sizeof(void *)) ? 1 : -1];
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashWriteCbkArg
+****************************************************************************//**
+*
+* Returns Cy_Hpi_FlashWriteCbk as the cbk argument of hpi_flash_row_write.
+* ISO C does not define a cast from a function pointer to a void pointer, so
+* the representation of the cy_hpi_flash_write_cbk_t value is copied instead.
+* The flash driver converts it back to its callback type.
+*
+*******************************************************************************/
+static void *Cy_Hpi_FlashWriteCbkArg(void)
+{
+    cy_hpi_flash_write_cbk_t cbk = Cy_Hpi_FlashWriteCbk;
+    void *arg = NULL;
+
+    (void)memcpy(&arg, &cbk, sizeof(arg));
+
+    return arg;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowDone
+****************************************************************************//**
+*
+* Records that a tracked row has been programmed. Only programmed rows are
+* recorded in the journal, so a transfer resumed after a reset does not skip
+* a row whose write did not complete.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashRowDone(cy_stc_hpi_flash_ctx_t *flashCtx, uint16_t rowNum)
+{
+    if ((flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE) &&
+        (((uint32_t)rowNum + 1U) == flashCtx->imageNextRow))
+    {
+        flashCtx->imageDoneRow = flashCtx->imageNextRow;
+        flashCtx->imageDoneCrc = flashCtx->imageCrc;
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashProcessWriteDone
+****************************************************************************//**
+*
+* Records the result of a completed non-blocking flash write.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashProcessWriteDone(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    if (flashCtx->writeStatus == CY_HPI_FLASH_WRITE_COMPLETE)
+    {
+        Cy_Hpi_FlashRowDone(flashCtx, flashCtx->writeRow);
+    }
+    else
+    {
+        if (!flashCtx->writeFailed)
+        {
+            flashCtx->failedRow = flashCtx->writeRow;
+        }
+        flashCtx->writeFailed = true;
+
+        /* The EC has to rewrite the row, so the image is no longer
+         * written in order. */
+        if (flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE)
+        {
+            flashCtx->imageState = CY_HPI_FLASH_IMAGE_UNTRACKED;
+        }
+    }
+
+    /* The row is either programmed or tracking has stopped. */
+    Cy_Hpi_FlashJournalUpdate(flashCtx);
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashWriteBusy
+****************************************************************************//**
+*
+* Samples the state of the non-blocking flash write and records the result of
+* a write which completed before the sample. A write which completes after
+* the sample is recorded by the next call.
+*
+* \return
+* true if a non-blocking flash write was in progress when sampled.
+*
+*******************************************************************************/
+static bool Cy_Hpi_FlashWriteBusy(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    uint32_t intrState;
+    bool writeBusy;
+    bool writeDone;
+
+    intrState = Cy_SysLib_EnterCriticalSection();
+    writeBusy = flashCtx->writeBusy;
+    writeDone = flashCtx->writeDone;
+    flashCtx->writeDone = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+
+    if (writeDone)
+    {
+        Cy_Hpi_FlashProcessWriteDone(flashCtx);
+    }
+
+    return writeBusy;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTrackRow
+****************************************************************************//**
+*
+* Updates the running image CRC with a row which is about to be written.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashTrackRow(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                 uint16_t rowNum,
+                                 const uint8_t *data)
+{
+    if (flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE)
+    {
+        if ((rowNum == flashCtx->imageNextRow) && (rowNum < flashCtx->imageEndRow))
+        {
+            flashCtx->imageCrc = Cy_Hpi_FlashCrc32(flashCtx->imageCrc, data,
+                                                   Cy_Hpi_FlashRowSize(flashCtx->ptrHpiContext));
+            flashCtx->imageNextRow++;
+        }
+        else
+        {
+            flashCtx->imageState = CY_HPI_FLASH_IMAGE_UNTRACKED;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowWriteFailed
+****************************************************************************//**
+*
+* Stops image tracking after a row could not be written.
+*
+*******************************************************************************/
+static void Cy_Hpi_FlashRowWriteFailed(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    if (flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE)
+    {
+        flashCtx->imageState = CY_HPI_FLASH_IMAGE_UNTRACKED;
+        Cy_Hpi_FlashJournalUpdate(flashCtx);
+    }
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashModeActive
+****************************************************************************//**
+*
+* Returns true if the EC has entered flashing mode through HPI.
+*
+*******************************************************************************/
+static bool Cy_Hpi_FlashModeActive(const cy_stc_hpi_context_t *context)
+{
+    return ((context->ptrAppCbk->hpi_flash_access_get_status != NULL) &&
+            (context->ptrAppCbk->hpi_flash_access_get_status(CY_HPI_FLASH_IF_HPI_MASK)));
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowWriteCheck
+****************************************************************************//**
+*
+* Checks that the EC has entered flashing mode through HPI, and that the row
+* follows the bootloader rows and is within the flash, as the HPI library does
+* for the row writes it handles.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashRowWriteCheck(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                      uint16_t rowNum)
+{
+    cy_stc_hpi_context_t *context = flashCtx->ptrHpiContext;
+    uint16_t rowCnt = context->flashConfig.flashRowCnt;
+
+    if (!Cy_Hpi_FlashModeActive(context))
+    {
+        return CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+    }
+
+    if ((rowNum <= context->flashConfig.blLastRow) || ((rowCnt != 0U) && (rowNum >= rowCnt)))
+    {
+        return CY_HPI_RESPONSE_INVALID_ARGUMENT;
+    }
+
+    return CY_HPI_RESPONSE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashStartWrite
+****************************************************************************//**
+*
+* Starts a non-blocking write of the given row from the staging buffer. The
+* row data must already be in place.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashStartWrite(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                   uint16_t rowNum)
+{
+    cy_stc_hpi_context_t *context = flashCtx->ptrHpiContext;
+    cy_en_hpi_response_t code = Cy_Hpi_FlashRowWriteCheck(flashCtx, rowNum);
+
+    if (code != CY_HPI_RESPONSE_SUCCESS)
+    {
+        return code;
+    }
+    code = CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+
+    /* Do not start new writes after a failure; the EC has to flush and
+     * restart the update from the failed row. */
+    if ((context->ptrAppCbk->hpi_flash_row_write != NULL) && (!flashCtx->writeFailed))
+    {
+        Cy_Hpi_FlashTrackRow(flashCtx, rowNum, Cy_Hpi_FlashRowData(flashCtx));
+
+        flashCtx->writeRow  = rowNum;
+        flashCtx->writeBusy = true;
+
+        if (context->ptrAppCbk->hpi_flash_row_write(rowNum, Cy_Hpi_FlashRowData(flashCtx),
+                                                     Cy_Hpi_FlashWriteCbkArg()) == 0)
+        {
+            code = CY_HPI_RESPONSE_SUCCESS;
+        }
+        else
+        {
+            flashCtx->writeBusy = false;
+            Cy_Hpi_FlashRowWriteFailed(flashCtx);
+        }
+    }
+
+    return code;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRleExpand
+****************************************************************************//**
+*
+* Expands run-length encoded row data. Each block starts with a control byte:
+* if bit 7 is set, the next byte is repeated ((ctrl & 0x7F) + 1) times;
+* otherwise (ctrl + 1) literal bytes follow.
+*
+* \return
+* true if exactly dstLen bytes were produced without reading past srcLen.
+*
+*******************************************************************************/
+static bool Cy_Hpi_FlashRleExpand(const uint8_t *src, uint16_t srcLen,
+                                  uint8_t *dst, uint16_t dstLen)
+{
+    uint16_t srcIdx = 0U;
+    uint16_t dstIdx = 0U;
+    uint16_t runLen;
+    uint8_t ctrl;
+
+    while (dstIdx < dstLen)
+    {
+        if (srcIdx >= srcLen)
+        {
+            return false;
+        }
+
+        ctrl   = src[srcIdx++];
+        runLen = (uint16_t)(ctrl & CY_HPI_FLASH_RLE_LEN_MASK) + 1U;
+
+        if ((uint32_t)dstIdx + runLen > dstLen)
+        {
+            return false;
+        }
+
+        if ((ctrl & CY_HPI_FLASH_RLE_REPEAT_FLAG) != 0U)
+        {
+            if (srcIdx >= srcLen)
+            {
+                return false;
+            }
+            (void)memset(&dst[dstIdx], (int)src[srcIdx], runLen);
+            srcIdx++;
+        }
+        else
+        {
+            if ((uint32_t)srcIdx + runLen > srcLen)
+            {
+                return false;
+            }
+            (void)memcpy(&dst[dstIdx], &src[srcIdx], runLen);
+            srcIdx += runLen;
+        }
+
+        dstIdx += runLen;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashRowCrc
+****************************************************************************//**
+*
+* Computes the CRC-32 of a range of flash rows and stores the values in the
+* flash data memory. The whole range must be within the flash, or within the
+* 16-bit row space if the flash size has not been set.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashRowCrc(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                               uint16_t rowNum,
+                                               uint8_t rowCount)
+{
+    cy_stc_hpi_context_t *context = flashCtx->ptrHpiContext;
+    uint8_t *rowData = Cy_Hpi_FlashRowData(flashCtx);
+    uint8_t *outPtr = context->regSpace.flashMem;
+    uint16_t rowSize = Cy_Hpi_FlashRowSize(context);
+    uint32_t rowLimit = context->flashConfig.flashRowCnt;
+    uint32_t crc;
+    uint8_t idx;
+
+    if (!Cy_Hpi_FlashModeActive(context))
+    {
+        return CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+    }
+
+    if (rowLimit == 0U)
+    {
+        rowLimit = (uint32_t)UINT16_MAX + 1U;
+    }
+
+    if ((rowCount == 0U) || (rowCount > CY_HPI_FLASH_ROW_CRC_MAX_COUNT) ||
+        (((uint32_t)rowNum + rowCount) > rowLimit))
+    {
+        return CY_HPI_RESPONSE_INVALID_ARGUMENT;
+    }
+
+    if (context->ptrAppCbk->hpi_flash_row_read == NULL)
+    {
+        return CY_HPI_RESPONSE_NOT_SUPPORTED;
+    }
+
+    for (idx = 0U; idx < rowCount; idx++)
+    {
+        if (context->ptrAppCbk->hpi_flash_row_read((uint16_t)(rowNum + idx), rowData) != 0)
+        {
+            return CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+        }
+
+        crc = ~Cy_Hpi_FlashCrc32(0xFFFFFFFFU, rowData, rowSize);
+
+        *outPtr++ = (uint8_t)crc;
+        *outPtr++ = (uint8_t)(crc >> 8);
+        *outPtr++ = (uint8_t)(crc >> 16);
+        *outPtr++ = (uint8_t)(crc >> 24);
+    }
+
+    return CY_HPI_RESPONSE_FLASH_DATA_AVAILABLE;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashImageBegin
+****************************************************************************//**
+*
+* Starts tracking the CRC of an image of the given firmware mode written to
+* the given range of rows.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashImageBegin(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                   uint16_t rowNum,
+                                                   uint16_t rowCount,
+                                                   uint8_t fwMode)
+{
+    uint16_t rowCnt = flashCtx->ptrHpiContext->flashConfig.flashRowCnt;
+    uint32_t endRow = (uint32_t)rowNum + rowCount;
+
+    if ((rowCount == 0U) || (endRow > 0xFFFFU) || ((rowCnt != 0U) && (endRow > rowCnt)))
+    {
+        return CY_HPI_RESPONSE_INVALID_ARGUMENT;
+    }
+
+    flashCtx->imageStartRow = rowNum;
+    flashCtx->imageEndRow   = (uint16_t)endRow;
+    flashCtx->imageNextRow  = rowNum;
+    flashCtx->imageCrc      = 0xFFFFFFFFU;
+    flashCtx->imageDoneRow  = rowNum;
+    flashCtx->imageDoneCrc  = 0xFFFFFFFFU;
+    flashCtx->imageFwMode   = fwMode;
+    flashCtx->imageState    = CY_HPI_FLASH_IMAGE_ACTIVE;
+    Cy_Hpi_FlashJournalUpdate(flashCtx);
+
+    return CY_HPI_RESPONSE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashImageEnd
+****************************************************************************//**
+*
+* Compares the running image CRC against the value expected by the EC.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashImageEnd(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                 uint32_t expCrc)
+{
+    cy_en_hpi_response_t code = CY_HPI_RESPONSE_CMD_FAILED;
+
+    if ((flashCtx->imageState == CY_HPI_FLASH_IMAGE_ACTIVE) &&
+        (flashCtx->imageDoneRow == flashCtx->imageEndRow) && (!flashCtx->writeFailed))
+    {
+        if ((~flashCtx->imageDoneCrc) == expCrc)
+        {
+            flashCtx->imageState = CY_HPI_FLASH_IMAGE_VERIFIED;
+            code = CY_HPI_RESPONSE_SUCCESS;
+        }
+        else
+        {
+            flashCtx->imageState = CY_HPI_FLASH_IMAGE_INVALID;
+            code = CY_HPI_RESPONSE_INVALID_FW;
+        }
+    }
+    else if (flashCtx->imageState != CY_HPI_FLASH_IMAGE_IDLE)
+    {
+        flashCtx->imageState = CY_HPI_FLASH_IMAGE_UNTRACKED;
+    }
+    else
+    {
+        /* No image transfer was started. */
+    }
+
+    Cy_Hpi_FlashJournalUpdate(flashCtx);
+
+    return code;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashProgress
+****************************************************************************//**
+*
+* Stores the image transfer progress in the flash data memory.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashProgress(cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    uint8_t *outPtr = flashCtx->ptrHpiContext->regSpace.flashMem;
+    uint32_t crc = ~flashCtx->imageDoneCrc;
+
+    outPtr[0]  = flashCtx->imageState;
+    outPtr[1]  = flashCtx->imageFwMode;
+    outPtr[2]  = (uint8_t)flashCtx->imageStartRow;
+    outPtr[3]  = (uint8_t)(flashCtx->imageStartRow >> 8);
+    outPtr[4]  = (uint8_t)flashCtx->imageEndRow;
+    outPtr[5]  = (uint8_t)(flashCtx->imageEndRow >> 8);
+    outPtr[6]  = (uint8_t)flashCtx->imageDoneRow;
+    outPtr[7]  = (uint8_t)(flashCtx->imageDoneRow >> 8);
+    outPtr[8]  = (uint8_t)crc;
+    outPtr[9]  = (uint8_t)(crc >> 8);
+    outPtr[10] = (uint8_t)(crc >> 16);
+    outPtr[11] = (uint8_t)(crc >> 24);
+
+    return CY_HPI_RESPONSE_FLASH_DATA_AVAILABLE;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashExecExtCmd
+****************************************************************************//**
+*
+* Executes an extended flash command. Must be called only when no
+* non-blocking flash write is in progress.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashExecExtCmd(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                   const uint8_t *param)
+{
+    cy_en_hpi_response_t code;
+
+    switch (param[1])
+    {
+        case CY_HPI_FLASH_EXT_ROW_CRC_CMD:
+            code = Cy_Hpi_FlashRowCrc(flashCtx,
+                                      (uint16_t)param[2] | ((uint16_t)param[3] << 8),
+                                      param[4]);
+            break;
+
+        case CY_HPI_FLASH_EXT_FILL_ROW_CMD:
+            (void)memset(Cy_Hpi_FlashRowData(flashCtx), (int)param[4],
+                         Cy_Hpi_FlashRowSize(flashCtx->ptrHpiContext));
+            code = Cy_Hpi_FlashStartWrite(flashCtx,
+                                          (uint16_t)param[2] | ((uint16_t)param[3] << 8));
+            break;
+
+        case CY_HPI_FLASH_EXT_IMAGE_BEGIN_CMD:
+            code = Cy_Hpi_FlashImageBegin(flashCtx,
+                                          (uint16_t)param[2] | ((uint16_t)param[3] << 8),
+                                          (uint16_t)param[4] | ((uint16_t)param[5] << 8),
+                                          param[6]);
+            break;
+
+        case CY_HPI_FLASH_EXT_IMAGE_END_CMD:
+            code = Cy_Hpi_FlashImageEnd(flashCtx,
+                                        (uint32_t)param[2] | ((uint32_t)param[3] << 8) |
+                                        ((uint32_t)param[4] << 16) | ((uint32_t)param[5] << 24));
+            break;
+
+        case CY_HPI_FLASH_EXT_PROGRESS_CMD:
+            code = Cy_Hpi_FlashProgress(flashCtx);
+            break;
+
+        default:
+            code = CY_HPI_RESPONSE_INVALID_COMMAND;
+            break;
+    }
+
+    return code;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashExecRwCmd
+****************************************************************************//**
+*
+* Executes a flash read/write command. Must be called only when no
+* non-blocking flash write is in progress.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashExecRwCmd(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                  uint8_t cmd,
+                                                  uint16_t rowNum)
+{
+    cy_stc_hpi_context_t *context = flashCtx->ptrHpiContext;
+    cy_stc_hpi_app_cbk_t *appCbk = context->ptrAppCbk;
+    cy_en_hpi_response_t code = CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+
+    switch (cmd)
+    {
+        case CY_HPI_FLASH_ROW_READ_CMD:
+            if ((appCbk->hpi_flash_row_read != NULL) &&
+                (appCbk->hpi_flash_row_read(rowNum, context->regSpace.flashMem) == 0))
+            {
+                code = CY_HPI_RESPONSE_FLASH_DATA_AVAILABLE;
+            }
+            break;
+
+        case CY_HPI_FLASH_ROW_WRITE_CMD:
+            code = Cy_Hpi_FlashRowWriteCheck(flashCtx, rowNum);
+            if (code != CY_HPI_RESPONSE_SUCCESS)
+            {
+                break;
+            }
+
+            Cy_Hpi_FlashTrackRow(flashCtx, rowNum, context->regSpace.flashMem);
+            if ((appCbk->hpi_flash_row_write != NULL) &&
+                (appCbk->hpi_flash_row_write(rowNum, context->regSpace.flashMem, NULL) == 0))
+            {
+                Cy_Hpi_FlashRowDone(flashCtx, rowNum);
+                Cy_Hpi_FlashJournalUpdate(flashCtx);
+            }
+            else
+            {
+                Cy_Hpi_FlashRowWriteFailed(flashCtx);
+                code = CY_HPI_RESPONSE_FLASH_UPDATE_FAILED;
+            }
+            break;
+
+        case CY_HPI_FLASH_ROW_STREAM_WRITE_CMD:
+            (void)memcpy(Cy_Hpi_FlashRowData(flashCtx), context->regSpace.flashMem,
+                         Cy_Hpi_FlashRowSize(context));
+            code = Cy_Hpi_FlashStartWrite(flashCtx, rowNum);
+            break;
+
+        case CY_HPI_FLASH_ROW_RLE_WRITE_CMD:
+            if (Cy_Hpi_FlashRleExpand(context->regSpace.flashMem, CY_HPI_MAX_FLASH_ROW_SIZE,
+                                      Cy_Hpi_FlashRowData(flashCtx), Cy_Hpi_FlashRowSize(context)))
+            {
+                code = Cy_Hpi_FlashStartWrite(flashCtx, rowNum);
+            }
+            else
+            {
+                code = CY_HPI_RESPONSE_INVALID_ARGUMENT;
+            }
+            break;
+
+        case CY_HPI_FLASH_STREAM_FLUSH_CMD:
+            if (!flashCtx->writeFailed)
+            {
+                code = CY_HPI_RESPONSE_SUCCESS;
+            }
+            flashCtx->writeFailed = false;
+            break;
+
+        default:
+            code = CY_HPI_RESPONSE_INVALID_ARGUMENT;
+            break;
+    }
+
+    return code;
+}
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashExecCmd
+****************************************************************************//**
+*
+* Executes a flash command received through the given device register.
+*
+*******************************************************************************/
+static cy_en_hpi_response_t Cy_Hpi_FlashExecCmd(cy_stc_hpi_flash_ctx_t *flashCtx,
+                                                uint8_t cmdOpcode,
+                                                const uint8_t *param)
+{
+    if (cmdOpcode == (uint8_t)CY_HPI_FLASH_EXT_CMD_REG)
+    {
+        return Cy_Hpi_FlashExecExtCmd(flashCtx, param);
+    }
+
+    return Cy_Hpi_FlashExecRwCmd(flashCtx, param[1],
+                                 (uint16_t)param[2] | ((uint16_t)param[3] << 8));
+}
+
+cy_en_hpi_status_t Cy_Hpi_FlashInit(cy_stc_hpi_context_t *context,
+                                    cy_stc_hpi_flash_ctx_t *flashCtx)
+{
+    if ((context == NULL) || (flashCtx == NULL) || (context->ptrAppCbk == NULL))
+    {
+        return CY_HPI_STAT_INVALID_ARGS;
+    }
+
+    (void)memset(flashCtx, 0, sizeof(cy_stc_hpi_flash_ctx_t));
+    flashCtx->ptrHpiContext = context;
+    flashCtx->pendingOpcode = CY_HPI_FLASH_CMD_NONE;
+    Cy_Hpi_FlashJournalRestore(flashCtx);
+
+    gl_HpiFlashCtx = flashCtx;
+
+    return CY_HPI_STAT_SUCCESS;
+}
+
+bool Cy_Hpi_FlashDevWriteHandler(cy_stc_hpi_context_t *context,
+                                 uint8_t cmdOpcode,
+                                 uint8_t *cmdParam,
+                                 uint8_t cmdLength,
+                                 cy_en_hpi_status_t *stat,
+                                 cy_en_hpi_response_t *code)
+{
+    cy_stc_hpi_flash_ctx_t *flashCtx = gl_HpiFlashCtx;
+    bool writeBusy;
+    bool cmdPending;
+
+    if ((flashCtx == NULL) || (flashCtx->ptrHpiContext != context))
+    {
+        return false;
+    }
+
+    writeBusy  = Cy_Hpi_FlashWriteBusy(flashCtx);
+    cmdPending = (flashCtx->pendingOpcode != CY_HPI_FLASH_CMD_NONE);
+
+    if (cmdOpcode == (uint8_t)CY_HPI_DEV_REG_FLASH_READ_WRITE)
+    {
+        if ((cmdLength < CY_HPI_FLASH_READ_WRITE_CMD_LEN) ||
+            (cmdParam[0] != (uint8_t)CY_HPI_FLASH_READ_WRITE_CMD_SIG))
+        {
+            return false;
+        }
+    }
+    else if (cmdOpcode == (uint8_t)CY_HPI_DEV_REG_VALIDATE_FW_ADDR)
+    {
+        /* The last row of the image may still be programmed. */
+        if ((writeBusy) || (cmdPending))
+        {
+            *stat = CY_HPI_STAT_SUCCESS;
+            *code = CY_HPI_FLASH_RESPONSE_BUSY;
+            return true;
+        }
+
+        /* Use the result of the incremental image check, if available for
+         * the image being validated. */
+        if (((flashCtx->imageState != CY_HPI_FLASH_IMAGE_VERIFIED) &&
+             (flashCtx->imageState != CY_HPI_FLASH_IMAGE_INVALID)) ||
+            (flashCtx->imageFwMode == 0U) || (cmdLength < 1U) || (cmdParam[0] != flashCtx->imageFwMode))
+        {
+            flashCtx->imageState = CY_HPI_FLASH_IMAGE_IDLE;
+            Cy_Hpi_FlashJournalUpdate(flashCtx);
+            return false;
+        }
+
+        *stat = CY_HPI_STAT_SUCCESS;
+        *code = (flashCtx->imageState == CY_HPI_FLASH_IMAGE_VERIFIED) ?
+                CY_HPI_RESPONSE_SUCCESS : CY_HPI_RESPONSE_INVALID_FW;
+        flashCtx->imageState = CY_HPI_FLASH_IMAGE_IDLE;
+        return true;
+    }
+    else if (cmdOpcode == (uint8_t)CY_HPI_FLASH_EXT_CMD_REG)
+    {
+        if ((cmdLength < 2U) || (cmdLength > CY_HPI_FLASH_EXT_CMD_MAX_LEN) ||
+            (cmdParam[0] != (uint8_t)CY_HPI_FLASH_EXT_CMD_SIG))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    /* Plain row read and write commands are left to the HPI library unless
+     * they would overlap with a streamed write or belong to a tracked image. */
+    if ((cmdOpcode == (uint8_t)CY_HPI_DEV_REG_FLASH_READ_WRITE) && (!writeBusy) && (!cmdPending) &&
+        ((cmdParam[1] == CY_HPI_FLASH_ROW_READ_CMD) ||
+         ((cmdParam[1] == CY_HPI_FLASH_ROW_WRITE_CMD) &&
+          (flashCtx->imageState != CY_HPI_FLASH_IMAGE_ACTIVE))))
+    {
+        return false;
+    }
+
+    *stat = CY_HPI_STAT_SUCCESS;
+
+    /* Only one command is delayed at a time; the parameters of the delayed
+     * command must not be overwritten. */
+    if (cmdPending)
+    {
+        *code = CY_HPI_FLASH_RESPONSE_BUSY;
+        return true;
+    }
+
+    /* Parameters not sent by the EC read as zero. */
+    (void)memset(flashCtx->pendingParam, 0, CY_HPI_FLASH_EXT_CMD_MAX_LEN);
+    (void)memcpy(flashCtx->pendingParam, cmdParam,
+                 (cmdLength < CY_HPI_FLASH_EXT_CMD_MAX_LEN) ? cmdLength : CY_HPI_FLASH_EXT_CMD_MAX_LEN);
+
+    if (writeBusy)
+    {
+        /* The response is sent from Cy_Hpi_FlashTask once the row being
+         * programmed is done. */
+        flashCtx->pendingOpcode = cmdOpcode;
+        *code = CY_HPI_RESPONSE_NO_RESPONSE;
+    }
+    else
+    {
+        *code = Cy_Hpi_FlashExecCmd(flashCtx, cmdOpcode, flashCtx->pendingParam);
+    }
+
+    return true;
+}
+
+void Cy_Hpi_FlashTask(cy_stc_hpi_context_t *context)
+{
+    cy_stc_hpi_flash_ctx_t *flashCtx = gl_HpiFlashCtx;
+    cy_en_hpi_response_t code;
+    uint8_t cmdOpcode;
+
+    if ((flashCtx == NULL) || (flashCtx->ptrHpiContext != context))
+    {
+        return;
+    }
+
+    if ((!Cy_Hpi_FlashWriteBusy(flashCtx)) && (flashCtx->pendingOpcode != CY_HPI_FLASH_CMD_NONE))
+    {
+        cmdOpcode = flashCtx->pendingOpcode;
+        flashCtx->pendingOpcode = CY_HPI_FLASH_CMD_NONE;
+
+        code = Cy_Hpi_FlashExecCmd(flashCtx, cmdOpcode, flashCtx->pendingParam);
+        (void)Cy_Hpi_RegEnqueueEvent(context, CY_HPI_REG_SECTION_DEV, (uint8_t)code, 0U, NULL);
+    }
+}
+
+bool Cy_Hpi_FlashIsIdle(cy_stc_hpi_context_t *context)
+{
+    cy_stc_hpi_flash_ctx_t *flashCtx = gl_HpiFlashCtx;
+
+    if ((flashCtx == NULL) || (flashCtx->ptrHpiContext != context))
+    {
+        return true;
+    }
+
+    return ((!flashCtx->writeBusy) && (!flashCtx->writeDone) &&
+            (flashCtx->pendingOpcode == CY_HPI_FLASH_CMD_NONE));
+}
+
+#endif /* ((CY_HPI_FLASH_EXT_ENABLE) && ((SROM_CODE_HPISS_HPI == MODULE_IN_ROM) || (CY_HPI_FLASH_RW_ENABLE))) */
+
+/* [] END OF FILE */
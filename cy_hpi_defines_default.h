@@ -60,6 +60,10 @@
 #define CY_HPI_FLASH_RW_ENABLE                     (0U)
 #endif /* CY_HPI_FLASH_RW_ENABLE */
 
+#ifndef CY_HPI_FLASH_EXT_ENABLE
+#define CY_HPI_FLASH_EXT_ENABLE                    (0U)
+#endif /* CY_HPI_FLASH_EXT_ENABLE */
+
 #ifndef TEST_CODE_COVERAGE
 #define TEST_CODE_COVERAGE                         (0U)
 #endif /* TEST_CODE_COVERAGE */
@@ -0,0 +1,465 @@
+/***************************************************************************//**
+* \file cy_hpi_flash.h
+* \version 1.1.0
+*
+* Defines the APIs, macros, and data structures for the HPI flash update
+* extensions.
+*
+********************************************************************************
+* \copyright
+* (c) 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_HPI_FLASH_H)
+#define CY_HPI_FLASH_H
+
+#include "cy_hpi.h"
+
+/**
+********************************************************************************
+* \addtogroup group_hpi_slave
+* \{
+*
+* The HPI flash update extensions are provided in source form
+* (COMPONENT_HPI_SLAVE_FLASH_EXT): add HPI_SLAVE_FLASH_EXT to the COMPONENTS
+* of the application. They are enabled with CY_HPI_FLASH_EXT_ENABLE and
+* require CY_HPI_FLASH_RW_ENABLE. They are implemented on top of the
+* hpi_dev_wr_handler_ext callback: commands that are not handled by the
+* extension are passed on to the HPI library unchanged.
+*
+* <b>Streaming row writes:</b>
+* The extension owns a second flash row buffer. When the EC issues the
+* FLASH_READ_WRITE command with \ref CY_HPI_FLASH_ROW_STREAM_WRITE_CMD, the
+* content of the flash data memory is copied into this buffer and the row is
+* programmed using the non-blocking mode of hpi_flash_row_write. The SUCCESS
+* response is sent as soon as the copy is done, so that the EC can transfer the
+* next row while the previous one is programmed. If a row is still being
+* programmed when the next command arrives, the response to that command is
+* delayed until the flash write completes. Only one command is delayed at a
+* time: a flash command received while a response is delayed, and a
+* VALIDATE_FW command received while a row is programmed, are not executed
+* and are answered with \ref CY_HPI_FLASH_RESPONSE_BUSY. The EC should issue
+* \ref CY_HPI_FLASH_STREAM_FLUSH_CMD after the last row and before any
+* VALIDATE_FW, JUMP_TO_BOOT, or RESET command.
+*
+* Rows are written by the extension only after the EC has entered flashing
+* mode with the ENTER_FLASH_MODE command, as reported by
+* hpi_flash_access_get_status, and only if the row follows the bootloader rows
+* and is within the flash, as set with Cy_Hpi_SetFlashParams. Otherwise the
+* streamed, compressed, fill, and tracked row writes are answered with
+* CY_HPI_RESPONSE_FLASH_UPDATE_FAILED or CY_HPI_RESPONSE_INVALID_ARGUMENT.
+*
+* <b>Extended flash commands:</b>
+* Additional commands are issued through the reserved device register at
+* \ref CY_HPI_FLASH_EXT_CMD_REG. The command layout is: signature
+* (\ref CY_HPI_FLASH_EXT_CMD_SIG), command code, and up to six bytes of
+* command parameters. Multi-byte parameters are little endian. The HPI slave
+* libraries pass every device register write, including writes to reserved
+* registers, to hpi_dev_wr_handler_ext before their own register handling,
+* so the register is only handled by the extension. This holds for the
+* libraries of this release (HPI_SLAVE_BOOT and HPI_SLAVE_HVMCU); check it
+* again when updating the slave library.
+*
+* \ref CY_HPI_FLASH_EXT_ROW_CRC_CMD takes a 16-bit start row and a row count
+* (up to \ref CY_HPI_FLASH_ROW_CRC_MAX_COUNT). It is accepted only in
+* flashing mode, and all rows of the range must be within the flash. The
+* CRC-32 (IEEE 802.3) of each row, as read through hpi_flash_row_read, is
+* stored in the flash data memory as an array of little endian 32-bit values
+* and the CY_HPI_RESPONSE_FLASH_DATA_AVAILABLE response is sent. The EC can compare
+* these values against the new image and write only the rows that differ.
+*
+* \ref CY_HPI_FLASH_EXT_FILL_ROW_CMD takes a 16-bit row number and a fill
+* byte, and programs the row with the fill byte. This avoids transferring rows
+* that are erased (0xFF) or zero filled.
+*
+* <b>Compressed row writes:</b>
+* With \ref CY_HPI_FLASH_ROW_RLE_WRITE_CMD, the flash data memory holds the
+* row data in run-length encoded form. Each block starts with a control byte:
+* if bit 7 is set, the following byte is repeated ((control & 0x7F) + 1)
+* times; otherwise (control + 1) literal bytes follow. The encoded data must
+* expand to exactly one flash row and fit in the flash data memory; the EC
+* should send rows that do not compress with
+* \ref CY_HPI_FLASH_ROW_STREAM_WRITE_CMD instead. The EC needs to write only
+* the encoded bytes to the flash data memory. The row is expanded into the
+* staging buffer and programmed in the same way as a streamed row write.
+*
+* <b>Incremental image validation:</b>
+* The EC can start an image transfer with \ref CY_HPI_FLASH_EXT_IMAGE_BEGIN_CMD,
+* which takes the 16-bit start row and 16-bit row count of the image, and the
+* firmware mode of the image (1 for FW1, 2 for FW2) as used by the VALIDATE_FW
+* command. While the rows of the image are written in order, a CRC-32 of the written row data is
+* updated with each row. \ref CY_HPI_FLASH_EXT_IMAGE_END_CMD takes the
+* expected CRC-32 of the complete image (all rows, flash row size bytes each)
+* and compares it against the running value. The response is:
+* - CY_HPI_RESPONSE_SUCCESS if the image matches. The following VALIDATE_FW
+*   command for the firmware mode of the image is answered with success
+*   without reading back the image.
+* - CY_HPI_RESPONSE_INVALID_FW if all rows were written in order but the CRC
+*   does not match. The following VALIDATE_FW command for the firmware mode of
+*   the image is answered with CY_HPI_RESPONSE_INVALID_FW.
+* - CY_HPI_RESPONSE_CMD_FAILED if rows were skipped, written out of order, or
+*   failed to program. The following VALIDATE_FW command is handled by the
+*   HPI library, which checks the complete image through
+*   hpi_boot_validate_fw_cmd.
+*
+* A VALIDATE_FW command for another firmware mode, or after an image begin
+* command without a firmware mode (0), is handled by the HPI library.
+*
+* Note that hpi_boot_validate_fw_cmd is not called when the incremental result
+* is used. Applications whose validation callback has side effects that are
+* needed after a firmware update should not use the image commands.
+*
+* <b>Resuming an interrupted image transfer:</b>
+* Each time a row of the tracked image is programmed successfully, the
+* progress is recorded in a journal kept in SRAM that is not initialized at
+* start-up (CY_NOINIT), so that it is retained across a soft reset.
+* \ref Cy_Hpi_FlashInit restores the image tracking state from a valid
+* journal. \ref CY_HPI_FLASH_EXT_PROGRESS_CMD stores the following fields
+* in the flash data memory and sends the CY_HPI_RESPONSE_FLASH_DATA_AVAILABLE
+* response:
+* - Byte 0: Image tracking state (CY_HPI_FLASH_IMAGE_*).
+* - Byte 1: Firmware mode of the image.
+* - Bytes 2-3: First row of the image.
+* - Bytes 4-5: Row following the last row of the image.
+* - Bytes 6-7: Next row to write. All rows before it are programmed.
+* - Bytes 8-11: CRC-32 of the rows programmed so far.
+*
+* If the state is CY_HPI_FLASH_IMAGE_ACTIVE, the EC can check the CRC against
+* its copy of the image and resume the transfer from the next row without
+* sending IMAGE_BEGIN again. The journal is cleared by IMAGE_BEGIN,
+* IMAGE_END, and VALIDATE_FW, and does not survive a power cycle.
+*
+* \} */
+
+/**
+* \addtogroup group_hpis_macros
+* \{
+*/
+
+/** Signature for valid flash read/write requests. */
+#define CY_HPI_FLASH_READ_WRITE_CMD_SIG            ('F')
+
+/** Minimum number of parameter bytes in a flash read/write request. */
+#define CY_HPI_FLASH_READ_WRITE_CMD_LEN            (4U)
+
+/** Flash read/write command code to read a flash row. */
+#define CY_HPI_FLASH_ROW_READ_CMD                  (0x00U)
+
+/** Flash read/write command code to write a flash row (blocking). */
+#define CY_HPI_FLASH_ROW_WRITE_CMD                 (0x01U)
+
+/** Flash read/write command code to write a flash row in streaming mode.
+ *  The response is sent once the row data has been copied and programming
+ *  has started. */
+#define CY_HPI_FLASH_ROW_STREAM_WRITE_CMD          (0x02U)
+
+/** Flash read/write command code to wait for all streamed rows to be
+ *  programmed. The response reports whether any streamed write failed. */
+#define CY_HPI_FLASH_STREAM_FLUSH_CMD              (0x03U)
+
+/** Flash read/write command code to write a flash row from run-length
+ *  encoded data, in streaming mode. */
+#define CY_HPI_FLASH_ROW_RLE_WRITE_CMD             (0x04U)
+
+/** Flashing interface bitmap of HPI, passed to hpi_flash_access_get_status. */
+#define CY_HPI_FLASH_IF_HPI_MASK                   (0x01U)
+
+/** Run-length encoding control byte flag for a repeated byte run. */
+#define CY_HPI_FLASH_RLE_REPEAT_FLAG               (0x80U)
+
+/** Run-length encoding control byte mask for the run length minus one. */
+#define CY_HPI_FLASH_RLE_LEN_MASK                  (0x7FU)
+
+/** Device register used for the extended flash commands. */
+#define CY_HPI_FLASH_EXT_CMD_REG                   (CY_HPI_DEV_REG_RESERVED_68H)
+
+/** Maximum number of bytes in an extended flash command. */
+#define CY_HPI_FLASH_EXT_CMD_MAX_LEN               (8U)
+
+/** Signature for valid extended flash command requests. */
+#define CY_HPI_FLASH_EXT_CMD_SIG                   ('X')
+
+/** Extended flash command code to read the CRC-32 of a range of flash rows. */
+#define CY_HPI_FLASH_EXT_ROW_CRC_CMD               (0x01U)
+
+/** Extended flash command code to program a flash row with a fill byte, in
+ *  streaming mode. */
+#define CY_HPI_FLASH_EXT_FILL_ROW_CMD              (0x02U)
+
+/** Extended flash command code to start tracking the CRC of an image. */
+#define CY_HPI_FLASH_EXT_IMAGE_BEGIN_CMD           (0x03U)
+
+/** Extended flash command code to check the CRC of the image written since
+ *  the image begin command. */
+#define CY_HPI_FLASH_EXT_IMAGE_END_CMD             (0x04U)
+
+/** Image tracking state: no image transfer is active. */
+#define CY_HPI_FLASH_IMAGE_IDLE                    (0x00U)
+
+/** Image tracking state: image rows are being written in order. */
+#define CY_HPI_FLASH_IMAGE_ACTIVE                  (0x01U)
+
+/** Image tracking state: the running CRC is not usable; VALIDATE_FW performs
+ *  the full image check. */
+#define CY_HPI_FLASH_IMAGE_UNTRACKED               (0x02U)
+
+/** Image tracking state: the image CRC matched the expected value. */
+#define CY_HPI_FLASH_IMAGE_VERIFIED                (0x03U)
+
+/** Image tracking state: the image CRC did not match the expected value. */
+#define CY_HPI_FLASH_IMAGE_INVALID                 (0x04U)
+
+/** Extended flash command code to read the image transfer progress. */
+#define CY_HPI_FLASH_EXT_PROGRESS_CMD              (0x05U)
+
+/** Size in bytes of the image transfer progress information. */
+#define CY_HPI_FLASH_PROGRESS_SIZE                 (12U)
+
+/** Signature of a valid image transfer progress journal. */
+#define CY_HPI_FLASH_JOURNAL_MAGIC                 (0x4A524E4CU)
+
+/** Maximum number of row CRCs returned by a single row CRC command. */
+#define CY_HPI_FLASH_ROW_CRC_MAX_COUNT             (CY_HPI_MAX_FLASH_ROW_SIZE / 4U)
+
+/** Value indicating that no flash command is pending. */
+#define CY_HPI_FLASH_CMD_NONE                      (0xFFU)
+
+/** Response to a flash command received while the extension is busy with the
+ *  previous one. The command is not executed; the EC sends it again after
+ *  the delayed response is received. */
+#define CY_HPI_FLASH_RESPONSE_BUSY                 (CY_HPI_RESPONSE_PORT_BUSY)
+
+/** \} group_hpis_macros */
+
+/**
+* \addtogroup group_hpis_enums
+* \{
+*/
+
+/**
+ * @typedef cy_en_hpi_flash_write_status_t
+ * @brief Status reported at the end of a non-blocking flash row write.
+ *
+ * These values match the status passed by the application flash driver to
+ * the callback registered through the cbk parameter of hpi_flash_row_write.
+ */
+typedef enum
+{
+    CY_HPI_FLASH_WRITE_COMPLETE            = 0,    /**< Flash write completed successfully. */
+    CY_HPI_FLASH_WRITE_ABORTED             = 1,    /**< Flash write was aborted. */
+    CY_HPI_FLASH_WRITE_COMPLETE_AND_ABORTED = 2,   /**< Flash write completed, subsequent writes aborted. */
+    CY_HPI_FLASH_WRITE_IN_PROGRESS         = 3     /**< Flash write is still in progress. */
+} cy_en_hpi_flash_write_status_t;
+
+/** \} group_hpis_enums */
+
+/**
+* \addtogroup group_hpis_data_structures
+* \{
+*/
+
+/**
+ * @typedef cy_hpi_flash_write_cbk_t
+ * @brief Callback invoked by the application flash driver when a non-blocking
+ * flash row write is finished.
+ */
+typedef void (*cy_hpi_flash_write_cbk_t)(
+        cy_en_hpi_flash_write_status_t status               /**< Flash write status. */
+        );
+
+/**
+ * @brief Image transfer progress journal, retained across soft reset.
+ */
+typedef struct
+{
+    uint32_t magic;                 /**< CY_HPI_FLASH_JOURNAL_MAGIC if the journal is in use. */
+    uint16_t startRow;              /**< First flash row of the image. */
+    uint16_t endRow;                /**< Flash row following the last row of the image. */
+    uint16_t nextRow;               /**< Flash row following the last programmed row. */
+    uint8_t fwMode;                 /**< Firmware mode of the image, or 0 if not specified. */
+    uint8_t reserved;               /**< Reserved for alignment. */
+    uint32_t crc;                   /**< Running CRC-32 of the programmed rows. */
+    uint32_t check;                 /**< CRC-32 of the preceding fields. */
+} cy_stc_hpi_flash_journal_t;
+
+/**
+ * @brief HPI flash update extension context information.
+ */
+typedef struct
+{
+    /** Flash row staging buffer. The first CY_SROM_API_PARAM_SIZE bytes are
+        reserved so that the buffer can be used in place as the SROM API
+        parameter block, in the same way as the sromApiArg and flashMem
+        members of the HPI register space. */
+    uint32_t rowBuf[(CY_SROM_API_PARAM_SIZE + CY_HPI_MAX_FLASH_ROW_SIZE) / 4U];
+
+    /** HPI library context pointer. */
+    cy_stc_hpi_context_t *ptrHpiContext;
+
+    /** Flash row which is being programmed. */
+    uint16_t writeRow;
+
+    /** Flash row whose streamed write failed. */
+    uint16_t failedRow;
+
+    /** Device register opcode of the command waiting for the current write
+        to complete, or CY_HPI_FLASH_CMD_NONE. */
+    uint8_t pendingOpcode;
+
+    /** Parameters of the pending command. */
+    uint8_t pendingParam[CY_HPI_FLASH_EXT_CMD_MAX_LEN];
+
+    /** Set while a non-blocking flash write is in progress. */
+    volatile bool writeBusy;
+
+    /** Set when a non-blocking flash write has finished and is not yet processed. */
+    volatile bool writeDone;
+
+    /** Status of the last non-blocking flash write. */
+    volatile cy_en_hpi_flash_write_status_t writeStatus;
+
+    /** Set when a streamed write failed since the last flush command. */
+    bool writeFailed;
+
+    /** Image tracking state (CY_HPI_FLASH_IMAGE_*). */
+    uint8_t imageState;
+
+    /** First flash row of the tracked image. */
+    uint16_t imageStartRow;
+
+    /** Flash row following the last row of the tracked image. */
+    uint16_t imageEndRow;
+
+    /** Next flash row expected in the tracked image. */
+    uint16_t imageNextRow;
+
+    /** Running CRC-32 of the tracked image rows written so far. */
+    uint32_t imageCrc;
+
+    /** Flash row following the last programmed row of the tracked image. */
+    uint16_t imageDoneRow;
+
+    /** Running CRC-32 of the programmed rows of the tracked image. */
+    uint32_t imageDoneCrc;
+
+    /** Firmware mode of the tracked image, or 0 if not specified. */
+    uint8_t imageFwMode;
+} cy_stc_hpi_flash_ctx_t;
+
+/** \} group_hpis_data_structures */
+
+/**
+* \addtogroup group_hpis_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashInit
+****************************************************************************//**
+*
+* Initializes the HPI flash update extensions. Call this function after
+* \ref Cy_Hpi_Init and \ref Cy_Hpi_SetFlashParams, and register
+* \ref Cy_Hpi_FlashDevWriteHandler as the hpi_dev_wr_handler_ext application
+* callback, or call it from the application's own handler. An image transfer
+* interrupted by a soft reset is restored from the progress journal.
+*
+* \param context
+* HPI library context pointer.
+*
+* \param flashCtx
+* Flash update extension context pointer. The structure must be retained for
+* as long as the HPI interface is active.
+*
+* \return
+* CY_HPI_STAT_SUCCESS - If the operation is successful.
+* CY_HPI_STAT_INVALID_ARGS - If the input parameter validation failed.
+*
+*******************************************************************************/
+cy_en_hpi_status_t Cy_Hpi_FlashInit(cy_stc_hpi_context_t *context,
+                                    cy_stc_hpi_flash_ctx_t *flashCtx);
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashDevWriteHandler
+****************************************************************************//**
+*
+* Handles the HPI device register writes related to the flash update
+* extensions. The function signature matches the hpi_dev_wr_handler_ext
+* application callback.
+*
+* \param context
+* HPI library context pointer.
+*
+* \param cmdOpcode
+* Offset address of the HPI device-specific register.
+*
+* \param cmdParam
+* Pointer to HPI command buffer.
+*
+* \param cmdLength
+* Write data count in bytes.
+*
+* \param stat
+* Parameter to store HPI status code.
+*
+* \param code
+* Parameter to store HPI response code. CY_HPI_RESPONSE_NO_RESPONSE is
+* returned when the response is delayed until the pending flash write
+* completes, and \ref CY_HPI_FLASH_RESPONSE_BUSY if a response is already
+* delayed.
+*
+* \return
+* true - If the command is handled by the flash update extension.
+* false - If the command is to be handled by the HPI library.
+*
+*******************************************************************************/
+bool Cy_Hpi_FlashDevWriteHandler(cy_stc_hpi_context_t *context,
+                                 uint8_t cmdOpcode,
+                                 uint8_t *cmdParam,
+                                 uint8_t cmdLength,
+                                 cy_en_hpi_status_t *stat,
+                                 cy_en_hpi_response_t *code);
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashTask
+****************************************************************************//**
+*
+* Processes completed non-blocking flash writes and sends the delayed
+* responses to the EC. Call this function periodically from the main task
+* loop of the firmware application, along with \ref Cy_Hpi_Task.
+*
+* \param context
+* HPI library context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_Hpi_FlashTask(cy_stc_hpi_context_t *context);
+
+/*******************************************************************************
+* Function name: Cy_Hpi_FlashIsIdle
+****************************************************************************//**
+*
+* Checks whether the flash update extension has any flash write or delayed
+* command in progress. The device should not enter Deep Sleep or be reset
+* while this function returns false.
+*
+* \param context
+* HPI library context pointer.
+*
+* \return
+* true - If no flash operation is in progress.
+* false - If a flash operation is in progress.
+*
+*******************************************************************************/
+bool Cy_Hpi_FlashIsIdle(cy_stc_hpi_context_t *context);
+
+/** \} group_hpis_functions */
+
+#endif /* CY_HPI_FLASH_H */
+
+/* [] END OF FILE */
@@ -148,10 +148,101 @@
 * - ptrEventQueue
 * - maxSlaveDevices
 * - ptrSlaves
-* - ptrScbBase
-* - ptrI2cContext
+* - ptrScbBase and ptrI2cContext, or ptrBuses and busCount
 * - respBuffLen
 * - ptrRespBuff
+* - ptrIntrMask (only if maxSlaveDevices is more than 32)
+* - ptrPrioMask (only if maxSlaveDevices is more than 32)
+* - ptrXferQueue and xferQueueSize (only if the asynchronous transaction API
+*   is used and ptrBuses is not provided)
+*
+* The following members are optional and select the scheduling policy of
+* \ref Cy_HPI_Master_Task:
+* - schedFlags
+* - slaveBudget
+* - evtBudget
+*
+* The optional respPrefetchLen member selects the number of response data
+* bytes read together with the port response header. Responses up to this
+* length are then read in a single I2C transfer.
+*
+* If the slave devices are connected to more than one I2C bus, set ptrBuses
+* to an array of \ref cy_hpi_master_bus_t, one per bus, with the SCB, the
+* I2C driver context, and the optional asynchronous transaction queue of
+* each bus, and register the slave devices with
+* \ref Cy_HPI_Master_SlaveDeviceBusInit. Each bus has its own asynchronous
+* transaction queue, so asynchronous transactions on different buses run at
+* the same time.
+*
+* The optional pollIntervalMin and pollIntervalMax members set the poll
+* interval range of the slave devices without an interrupt GPIO. See
+* \ref Cy_HPI_Master_PollTimerHandler.
+*
+* The optional ptrPortCache member enables the port register cache. See
+* \ref Cy_HPI_Master_PortRegRead.
+*
+* The optional failThreshold, backoffMin and backoffMax members configure the
+* slave device health tracking. Every failed register access counts, whether
+* made by the service of the slave device, by a port register, PD response or
+* group access, or by a queued transfer. A slave device with failThreshold
+* failed accesses without a successful service in between is quarantined: its
+* interrupts are ignored and register accesses to it return
+* CY_HPI_MASTER_SLAVE_QUARANTINED without an I2C transfer. After backoffMin,
+* counted by \ref Cy_HPI_Master_PollTimerHandler, the slave device is probed
+* by reading its Interrupt Status register. Each failed probe doubles the
+* backoff time, up to backoffMax. Entering quarantine, the start of a probe
+* and a successful probe are reported to the error handler with
+* CY_HPI_MASTER_SLAVE_QUARANTINED, CY_HPI_MASTER_SLAVE_PROBING and
+* CY_HPI_MASTER_SLAVE_RECOVERED; the start of a probe is reported from
+* \ref Cy_HPI_Master_Task.
+*
+* A blocking register access waits up to 50 ms for the queued transfer on
+* its bus to finish, and returns CY_HPI_MASTER_TIMEOUT if it does not.
+*
+* If the sclPort and sdaPort members of a bus are set, an I2C failure with
+* SDA held low starts the bus recovery sequence: the pins are switched to
+* GPIO, SCL is clocked up to nine times until the slave device releases SDA,
+* and a STOP condition is generated. The result is reported to the error
+* handler with CY_HPI_MASTER_BUS_RECOVERED or CY_HPI_MASTER_BUS_STUCK.
+*
+* The optional ptrEvtPool member enables the event data pool. Port event and
+* response data is then read from the slave device directly into a pool
+* block, and eventData passed to the event handler points into the block.
+* The application owns the block once the event handler is called, whatever
+* the handler returns, and releases it with \ref Cy_HPI_Master_EventRelease.
+* If no block is free, the data is passed through ptrRespBuff as without the
+* pool.
+*
+* To match the blocks to the event data sizes, set ptrEvtPool to an array of
+* evtPoolCount pools in increasing order of block size, for example with
+* CY_HPI_MASTER_EVT_POOL_BLOCK_SMALL, CY_HPI_MASTER_EVT_POOL_BLOCK_PDO,
+* CY_HPI_MASTER_EVT_POOL_BLOCK_VDM and CY_HPI_MASTER_EVT_POOL_BLOCK_EXT
+* blocks. The response header is read into a block of the pool with the
+* smallest blocks; if the event data does not fit, the header and the
+* prefetched data are moved to a block of the smallest pool it fits in, or
+* of a larger pool if that one is full. Queued events keep their block until
+* they are released, so events can be processed later or in batches without
+* dynamic memory allocation.
+*
+* Each register read writes the 16-bit register address and then reads the
+* data. The i2cCaps member of the application callbacks states whether
+* i2c_master_read does this as one transfer with a repeated start
+* (CY_HPI_MASTER_I2C_CAP_REPEATED_START) or with a STOP and a START, which
+* lets another master access the slave device between the two. If the flag
+* is clear and the optional i2c_master_write_read callback is provided, the
+* register reads are done with it as one combined transfer instead, and the
+* i2c_master_read_async and i2c_master_write_async callbacks are not used.
+* If only i2c_master_write_read is provided, i2c_master_read can be NULL.
+*
+* The optional ptrTrace member enables the transaction trace. The library
+* then time stamps each register transaction, asynchronous transactions from
+* the time they are queued, and each event from the slave interrupt to the
+* call of the event handler, with the get_timestamp application callback.
+* The latency, byte and error counts and a latency histogram are kept per
+* slave device and class in ptrStats, which holds
+* CY_HPI_MASTER_TRACE_STATS_ENTRIES(maxSlaveDevices) entries. If ptrRing is
+* set, the last ringSize transactions are also kept as records. See
+* \ref Cy_HPI_Master_GetTraceStats and \ref Cy_HPI_Master_GetTraceRecords.
 *
 * \param context
 * HPI master library context pointer.
@@ -199,7 +290,9 @@ cy_hpi_master_status_t Cy_HPI_Master_DeInit(cy_hpi_master_context_t *context);
 * HPI slave device I2C address (7 bits).
 *
 * \param intrGpioPort
-* HPI interrupt GPIO port number.
+* HPI interrupt GPIO port number. CY_HPI_MASTER_INTR_GPIO_NONE if the slave
+* device has no interrupt line; its Interrupt Status register is then polled
+* at the interval set by \ref Cy_HPI_Master_PollTimerHandler.
 *
 * \param intrGpioPin
 * HPI interrupt GPIO pin number.
@@ -219,6 +312,46 @@ cy_hpi_master_status_t Cy_HPI_Master_SlaveDeviceInit(cy_hpi_master_context_t *co
                                                   uint8_t intrGpioPin,
                                                   uint8_t portCount);
 
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_SlaveDeviceBusInit
+****************************************************************************//**
+*
+* Configures the HPI slave device information of a slave device connected to
+* one of the I2C buses listed in ptrBuses. See
+* \ref Cy_HPI_Master_SlaveDeviceInit. The slave device addresses must be
+* unique across all the buses of the HPI master context.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* HPI slave device I2C address (7 bits).
+*
+* \param intrGpioPort
+* HPI interrupt GPIO port number, or CY_HPI_MASTER_INTR_GPIO_NONE.
+*
+* \param intrGpioPin
+* HPI interrupt GPIO pin number.
+*
+* \param portCount
+* Number of PD ports supported by the slave device.
+*
+* \param busIdx
+* Index of the I2C bus in ptrBuses.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operations are successful.
+* CY_HPI_MASTER_FAILURE - If the slave registration failed.
+* CY_HPI_MASTER_INVALID_ARGS - If the input parameter validation failed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_SlaveDeviceBusInit(cy_hpi_master_context_t *context,
+                                                     uint8_t slaveAddr,
+                                                     uint8_t intrGpioPort,
+                                                     uint8_t intrGpioPin,
+                                                     uint8_t portCount,
+                                                     uint8_t busIdx);
+
 /*******************************************************************************
 * Function Name: Cy_HPI_Master_InterruptHandler
 ****************************************************************************//**
@@ -243,6 +376,61 @@ void Cy_HPI_Master_InterruptHandler(cy_hpi_master_context_t *context,
                                     uint8_t gpioPort, 
                                     uint8_t gpioPin);
 
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_PollTimerHandler
+****************************************************************************//**
+*
+* Advances the poll timers of the slave devices registered without an
+* interrupt GPIO, and marks the slave devices whose poll interval elapsed so
+* that \ref Cy_HPI_Master_Task reads their Interrupt Status register. Call
+* this function from a periodic timer interrupt or from the main loop.
+*
+* The poll interval of a slave device is set to pollIntervalMin when a poll
+* finds an interrupt, and doubles after each poll which finds none, up to
+* pollIntervalMax.
+*
+* This function also counts the backoff time of quarantined slave devices,
+* and marks them for a probe when it expires. If this function is not
+* called, quarantined slave devices are only probed after
+* \ref Cy_HPI_Master_SlaveProbe. It also counts the response timeout of a
+* firmware update started with \ref Cy_HPI_Master_FwUpdateStart.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param elapsed
+* Time elapsed since the previous call, in the unit of pollIntervalMin and
+* pollIntervalMax (typically milliseconds).
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_PollTimerHandler(cy_hpi_master_context_t *context,
+                                    uint16_t elapsed);
+
+/*******************************************************************************
+* Function Name: Cy_HPI_Master_SlaveInterruptHandler
+****************************************************************************//**
+*
+* Sets the interrupt pending bit of a slave device by its index. This is the
+* constant-time alternative to \ref Cy_HPI_Master_InterruptHandler, which
+* searches the slave list for the GPIO. Use it when the GPIO interrupt routine
+* can map the pin to a slave index, or when many slave devices are registered.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveIdx
+* Slave device index, in the order of \ref Cy_HPI_Master_SlaveDeviceInit calls.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_SlaveInterruptHandler(cy_hpi_master_context_t *context,
+                                         uint8_t slaveIdx);
+
 /*******************************************************************************
 * Function name: Cy_HPI_Master_Task
 ****************************************************************************//**
@@ -251,6 +439,20 @@ void Cy_HPI_Master_InterruptHandler(cy_hpi_master_context_t *context,
 * from the slave in the interrupt context and the associated data
 * in queue and is called periodically from the main loop of the application firmware.
 *
+* By default, all slave devices with a pending interrupt are serviced in
+* array order, and one queued event is dispatched once no interrupt is
+* pending. With CY_HPI_MASTER_SCHED_ROUND_ROBIN, up to slaveBudget slave
+* devices are serviced per call, starting after the one serviced last, and up
+* to evtBudget queued events are dispatched per call, so that a busy slave
+* device cannot delay the events of the others indefinitely. The slave
+* devices are serviced only once the events queued by the previous call are
+* dispatched, and servicing stops if the event queue becomes more than half
+* full: the slave devices hold their events until there is room for them,
+* instead of the queue overflowing. With
+* CY_HPI_MASTER_SCHED_FAULT_PRIORITY, fault events (OC, OV, OT) are delivered
+* to the event handler as soon as they are read, and slave devices reporting
+* faults are serviced before all others.
+*
 *
 * \param context
 * HPI master library context pointer.
@@ -280,6 +482,48 @@ void Cy_HPI_Master_Task(cy_hpi_master_context_t *context);
 *******************************************************************************/
 uint8_t Cy_HPI_Master_GetSlaveIndexByAddr(cy_hpi_master_context_t *context,
                                           uint8_t slaveAddr);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetSlaveHealth
+****************************************************************************//**
+*
+* Returns the health state of a slave device.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveIdx
+* Slave device index.
+*
+* \return
+* CY_HPI_MASTER_HEALTH_OK, CY_HPI_MASTER_HEALTH_QUARANTINED or
+* CY_HPI_MASTER_HEALTH_PROBING. CY_HPI_MASTER_HEALTH_QUARANTINED if slaveIdx
+* is not a registered slave device.
+*
+*******************************************************************************/
+uint8_t Cy_HPI_Master_GetSlaveHealth(cy_hpi_master_context_t *context,
+                                     uint8_t slaveIdx);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_SlaveProbe
+****************************************************************************//**
+*
+* Ends the backoff time of a quarantined slave device, so that the next
+* \ref Cy_HPI_Master_Task call probes it. Use it when the application knows
+* the slave device is back, for example after resetting it.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveIdx
+* Slave device index.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_SlaveProbe(cy_hpi_master_context_t *context,
+                              uint8_t slaveIdx);
     
 /******************************************************************************* 
 * Function name: Cy_HPI_Master_RegisterRead
@@ -305,6 +549,7 @@ uint8_t Cy_HPI_Master_GetSlaveIndexByAddr(cy_hpi_master_context_t *context,
 * \return
 * CY_HPI_MASTER_SUCCESS - If the operation is successful.
 * CY_HPI_MASTER_I2C_FAILURE - If the operation failed.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
 * CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
 *
 *******************************************************************************/    
@@ -338,6 +583,7 @@ cy_hpi_master_status_t Cy_HPI_Master_RegisterRead (cy_hpi_master_context_t *cont
 * \return
 * CY_HPI_MASTER_SUCCESS - If the operation is successful.
 * CY_HPI_MASTER_I2C_FAILURE - If the operation failed.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
 * CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
 *
 *******************************************************************************/     
@@ -347,6 +593,66 @@ cy_hpi_master_status_t Cy_HPI_Master_RegisterWrite(cy_hpi_master_context_t *cont
                                                  void *writeBuff,
                                                  uint16_t writeLen);
                                                  
+/*******************************************************************************
+* Function name: Cy_HPI_Master_DiscoverSlaves
+****************************************************************************//**
+*
+* Probes a list of I2C addresses on a bus and registers the HPI slave devices
+* which respond, so that no slave device table is needed. Call it after
+* \ref Cy_HPI_Master_Init, in place of or after
+* \ref Cy_HPI_Master_SlaveDeviceInit.
+*
+* The addresses are probed one after the other with blocking reads. Each
+* address is probed with one read of the Device Mode, Boot Mode Reason and
+* Silicon ID registers; an absent device fails in the address phase, without
+* waiting for a response timeout. The All Version registers are read only
+* from the devices which respond, and a device whose All Version read fails
+* is not registered. The port count is taken from the Device Mode register.
+* Addresses which are already registered are skipped. The pass stops once
+* maxDevices devices are discovered.
+*
+* Discovered slave devices are registered without an interrupt GPIO and are
+* polled (see \ref Cy_HPI_Master_PollTimerHandler). If a device has an
+* interrupt line, call \ref Cy_HPI_Master_SlaveInterruptHandler with its
+* slaveIdx from the GPIO interrupt.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param busIdx
+* Index of the I2C bus to probe.
+*
+* \param addrList
+* I2C addresses (7 bits) to probe. NULL probes CY_HPI_MASTER_ADDR_I2C_CFG_LOW,
+* CY_HPI_MASTER_ADDR_I2C_CFG_HIGH and CY_HPI_MASTER_ADDR_I2C_CFG_FLOAT.
+*
+* \param addrCount
+* Number of addresses in addrList. Ignored if addrList is NULL.
+*
+* \param devInfo
+* Array receiving the identification of the discovered devices. Can be NULL.
+*
+* \param maxDevices
+* Maximum number of devices to discover; the size of devInfo.
+*
+* \param devCount
+* Receives the number of discovered devices.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the probe pass is completed.
+* CY_HPI_MASTER_FAILURE - If a discovered device could not be registered
+* because maxSlaveDevices is reached.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_DiscoverSlaves(cy_hpi_master_context_t *context,
+                                                    uint8_t busIdx,
+                                                    const uint8_t *addrList,
+                                                    uint8_t addrCount,
+                                                    cy_hpi_master_dev_info_t *devInfo,
+                                                    uint8_t maxDevices,
+                                                    uint8_t *devCount);
+
 /******************************************************************************* 
 * Function name: Cy_HPI_Master_DevRegRead
 ****************************************************************************//**
@@ -477,6 +783,19 @@ cy_hpi_master_status_t Cy_HPI_Master_FlashMemoryWrite(cy_hpi_master_context_t *c
 *
 * Port register reads the API will be used to read all port-specific registers.
 *
+* If the port register cache is enabled, reads of the PD_STATUS,
+* TYPE_C_STATUS, CURRENT_PDO and CURRENT_RDO registers of the slave devices
+* initialized with \ref Cy_HPI_Master_SlaveDeviceInit are served from RAM
+* once the register was read. BUS_VOLTAGE shares a 4-byte register with
+* TYPE_C_STATUS but is not cached: it is always read from the device. The
+* cached registers are invalidated when
+* \ref Cy_HPI_Master_Task reads a connect, disconnect, negotiation complete,
+* swap complete, hard reset, error recovery, or reset complete event from
+* the port, and when any register of the port is written with
+* \ref Cy_HPI_Master_PortRegWrite.
+* Use \ref Cy_HPI_Master_PortCacheInvalidate if the registers may change
+* without one of these events, for example, if the events are masked.
+*
 * \param context
 * HPI master library context pointer.
 *
@@ -508,6 +827,29 @@ cy_hpi_master_status_t Cy_HPI_Master_PortRegRead(cy_hpi_master_context_t *contex
                                                  void *readBuff,
                                                  uint16_t readLen);
 
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PortCacheInvalidate
+****************************************************************************//**
+*
+* Invalidates the cached port registers of a slave device port.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param port
+* Slave port number, or CY_HPI_MASTER_PORT_ALL for all ports.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_PortCacheInvalidate(cy_hpi_master_context_t *context,
+                                       uint8_t slaveAddr,
+                                       uint8_t port);
+
 /*******************************************************************************
 * Function name: Cy_HPI_Master_PortRegWrite
 ****************************************************************************//**
@@ -545,6 +887,45 @@ cy_hpi_master_status_t Cy_HPI_Master_PortRegWrite(cy_hpi_master_context_t *conte
                                                     void *writeBuff,
                                                     uint16_t writeLen);
 
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PortStatusRead
+****************************************************************************//**
+*
+* Reads the PD_STATUS, TYPE_C_STATUS, BUS_VOLTAGE, CURRENT_PDO and
+* CURRENT_RDO registers of a port in a single I2C transfer and decodes them.
+* If the port register cache is enabled, the registers are read through the
+* cache, so only the registers not cached and BUS_VOLTAGE are read. The
+* BUS_CURRENT register
+* is read in a second transfer if requested.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param port
+* Slave port number.
+*
+* \param status
+* Pointer to the structure to store the port status.
+*
+* \param readCurrent
+* true to also read the VBus current.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operation is successful.
+* CY_HPI_MASTER_I2C_FAILURE - If the operation failed.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_PortStatusRead(cy_hpi_master_context_t *context,
+                                                    uint8_t slaveAddr,
+                                                    uint8_t port,
+                                                    cy_hpi_master_port_status_t *status,
+                                                    bool readCurrent);
+
 /*******************************************************************************
 * Function name: Cy_HPI_Master_PdResponseRegRead
 ***************************************************************************//**
@@ -619,6 +1000,99 @@ cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegWrite(cy_hpi_master_context_t
                                                     void *writeBuff,
                                                     uint16_t writeLen);
 
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PdResponseRegReadv
+****************************************************************************//**
+*
+* Reads a list of segments of the PD response registers. Consecutive
+* segments whose ranges are adjacent or overlap are read in a single I2C
+* transfer through the scratch buffer and copied to their buffers, so that,
+* for example, a VDM header and the data objects following it take one
+* transfer.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param port
+* Slave device port number.
+*
+* \param segs
+* Array of segments, in the order of increasing offset for the best merging.
+*
+* \param segCount
+* Number of segments.
+*
+* \param scratch
+* Buffer used to merge segments. Can be NULL to access each segment with its
+* own transfer.
+*
+* \param scratchLen
+* Size of the scratch buffer. A merged transfer is at most this long.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operation is successful.
+* CY_HPI_MASTER_I2C_FAILURE - If the operation failed.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegReadv(cy_hpi_master_context_t *context,
+                                                        uint8_t slaveAddr,
+                                                        uint8_t port,
+                                                        const cy_hpi_master_pd_seg_t *segs,
+                                                        uint8_t segCount,
+                                                        uint8_t *scratch,
+                                                        uint16_t scratchLen);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_PdResponseRegWritev
+****************************************************************************//**
+*
+* Writes a list of segments of the PD response write registers. Consecutive
+* segments whose ranges are adjacent or overlap are gathered in the scratch
+* buffer and written in a single I2C transfer. Where segments overlap, the
+* data of the later segment is written.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param port
+* Slave device port number.
+*
+* \param segs
+* Array of segments, in the order of increasing offset for the best merging.
+*
+* \param segCount
+* Number of segments.
+*
+* \param scratch
+* Buffer used to merge segments. Can be NULL to access each segment with its
+* own transfer.
+*
+* \param scratchLen
+* Size of the scratch buffer. A merged transfer is at most this long.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operation is successful.
+* CY_HPI_MASTER_I2C_FAILURE - If the operation failed.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegWritev(cy_hpi_master_context_t *context,
+                                                         uint8_t slaveAddr,
+                                                         uint8_t port,
+                                                         const cy_hpi_master_pd_seg_t *segs,
+                                                         uint8_t segCount,
+                                                         uint8_t *scratch,
+                                                         uint16_t scratchLen);
+
 /*******************************************************************************
 * Function name: Cy_HPI_Master_SleepAllowed
 ****************************************************************************//**
@@ -635,6 +1109,392 @@ cy_hpi_master_status_t Cy_HPI_Master_PdResponseRegWrite(cy_hpi_master_context_t
 *******************************************************************************/
 bool Cy_HPI_Master_SleepAllowed(cy_hpi_master_context_t *context);
 
+/*******************************************************************************
+* Function name: Cy_HPI_Master_EventRelease
+****************************************************************************//**
+*
+* Releases the event pool block holding the event data passed to the event
+* handler to the pool it was allocated from. Event data which is not held in
+* an event pool is ignored, so this function can be called for every event.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param eventData
+* eventData member of the event passed to the event handler.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_EventRelease(cy_hpi_master_context_t *context, uint8_t *eventData);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetQueueStats
+****************************************************************************//**
+*
+* Returns the event queue statistics.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param stats
+* Pointer to the structure to store the statistics.
+*
+* \param clear
+* true to clear the statistics after reading them.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operation is successful.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_GetQueueStats(cy_hpi_master_context_t *context,
+                                                   cy_hpi_master_queue_stats_t *stats,
+                                                   bool clear);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetTraceStats
+****************************************************************************//**
+*
+* Returns the transaction trace statistics of a slave device for one class of
+* transactions. A transaction which is retried is counted once per attempt,
+* so the errors member also counts the retries.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveIdx
+* Index of the slave device.
+*
+* \param traceClass
+* Transaction class (CY_HPI_MASTER_TRACE_CLASS_DEV to
+* CY_HPI_MASTER_TRACE_CLASS_EVENT).
+*
+* \param stats
+* Pointer to the structure to store the statistics.
+*
+* \param clear
+* true to clear the statistics after reading them.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the operation is successful.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed, or the trace is not
+* enabled.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_GetTraceStats(cy_hpi_master_context_t *context,
+                                                   uint8_t slaveIdx,
+                                                   uint8_t traceClass,
+                                                   cy_hpi_master_trace_stats_t *stats,
+                                                   bool clear);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GetTraceRecords
+****************************************************************************//**
+*
+* Copies the newest records of the transaction trace ring, oldest first.
+* The ring is not cleared.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param records
+* Array to store the records.
+*
+* \param maxCount
+* Number of records the array holds.
+*
+* \return
+* Number of records copied. 0 if the trace ring is not enabled.
+*
+*******************************************************************************/
+uint16_t Cy_HPI_Master_GetTraceRecords(cy_hpi_master_context_t *context,
+                                       cy_hpi_master_trace_rec_t *records,
+                                       uint16_t maxCount);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_RegisterReadAsync
+****************************************************************************//**
+*
+* Queues a register read and returns without waiting for the I2C transfer.
+* Transactions are executed in order. If the application provides the
+* i2c_master_read_async and i2c_master_write_async callbacks, each transfer
+* is started as soon as the previous one completes, from the context of
+* \ref Cy_HPI_Master_XferComplete; otherwise, or if the register reads use
+* i2c_master_write_read (see \ref Cy_HPI_Master_Init), the queued
+* transactions are executed with the blocking callbacks from
+* \ref Cy_HPI_Master_Task. The completion callback is always called from
+* \ref Cy_HPI_Master_Task.
+*
+* Blocking master APIs wait for the transfer on the bus to finish and hold
+* the queue while they use the bus, so they must not be called from the
+* interrupt that calls \ref Cy_HPI_Master_XferComplete.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param regAddress
+* HPI register address (16 bits).
+*
+* \param readBuff
+* Read data buffer pointer. Must stay valid until the transaction completes.
+*
+* \param readLen
+* Number of bytes to read.
+*
+* \param cbk
+* Completion callback. Can be NULL.
+*
+* \param tag
+* User tag passed to the completion callback.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the transaction is queued.
+* CY_HPI_MASTER_QUEUE_OVERFLOW - If the transaction queue is full.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_RegisterReadAsync(cy_hpi_master_context_t *context,
+                                                       uint8_t slaveAddr,
+                                                       uint16_t regAddress,
+                                                       uint8_t *readBuff,
+                                                       uint16_t readLen,
+                                                       cy_hpi_master_xfer_cbk_t cbk,
+                                                       void *tag);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_RegisterWriteAsync
+****************************************************************************//**
+*
+* Queues a register write and returns without waiting for the I2C transfer.
+* See \ref Cy_HPI_Master_RegisterReadAsync.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveAddr
+* Slave device I2C address (7 bits).
+*
+* \param regAddress
+* HPI register address (16 bits).
+*
+* \param writeBuff
+* Write data buffer pointer. Must stay valid until the transaction completes.
+*
+* \param writeLen
+* Number of bytes to write.
+*
+* \param cbk
+* Completion callback. Can be NULL.
+*
+* \param tag
+* User tag passed to the completion callback.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the transaction is queued.
+* CY_HPI_MASTER_QUEUE_OVERFLOW - If the transaction queue is full.
+* CY_HPI_MASTER_SLAVE_QUARANTINED - If the slave device is quarantined.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_RegisterWriteAsync(cy_hpi_master_context_t *context,
+                                                        uint8_t slaveAddr,
+                                                        uint16_t regAddress,
+                                                        void *writeBuff,
+                                                        uint16_t writeLen,
+                                                        cy_hpi_master_xfer_cbk_t cbk,
+                                                        void *tag);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_XferComplete
+****************************************************************************//**
+*
+* Reports the end of a transfer started through the i2c_master_read_async or
+* i2c_master_write_async callback on the first I2C bus, and starts the next
+* queued transaction. Call this function from the I2C or DMA completion
+* interrupt.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param success
+* true if the transfer completed successfully.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_XferComplete(cy_hpi_master_context_t *context, bool success);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_BusXferComplete
+****************************************************************************//**
+*
+* Reports the end of a non-blocking transfer on one of the I2C buses listed
+* in ptrBuses, and starts the next queued transaction of that bus. See
+* \ref Cy_HPI_Master_XferComplete.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param busIdx
+* Index of the I2C bus in ptrBuses.
+*
+* \param success
+* true if the transfer completed successfully.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_HPI_Master_BusXferComplete(cy_hpi_master_context_t *context, uint8_t busIdx, bool success);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_XferIdle
+****************************************************************************//**
+*
+* Checks whether the asynchronous transaction queue is empty.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \return
+* true - If no asynchronous transaction is queued or in progress.
+* false - Otherwise.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_XferIdle(cy_hpi_master_context_t *context);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_GroupWrite
+****************************************************************************//**
+*
+* Writes the same data to a register of several slave devices, for example,
+* the Event Mask register of a port. The writes are queued back to back on
+* the asynchronous transaction queue of the bus of each slave device, so the
+* writes on different buses run at the same time, and the function returns
+* once all of them are completed, or once none of them completed for 50 ms.
+* Slave devices on a bus without a queue are written with a blocking
+* transfer. Writes to a port register invalidate the port register cache of
+* the port.
+*
+* Only the I2C transfer of each write is checked. The function does not read
+* the Response register of the slave devices: a write to a command register
+* is answered through the slave interrupt, and the response is passed to the
+* event handler by \ref Cy_HPI_Master_Task as usual.
+*
+* The function also calls the completion callbacks of the other queued
+* transactions, so it must not be called from a completion callback.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param slaveIdxList
+* Indexes of the slave devices to write. NULL to write all the registered
+* slave devices, in slave index order.
+*
+* \param listLen
+* Number of entries in slaveIdxList. Ignored if slaveIdxList is NULL.
+*
+* \param regAddress
+* HPI register address (16 bits).
+*
+* \param writeBuff
+* Write data buffer pointer.
+*
+* \param writeLen
+* Number of bytes to write.
+*
+* \param slaveStatus
+* Array to store the status of each slave device, in the order of
+* slaveIdxList: CY_HPI_MASTER_SUCCESS, CY_HPI_MASTER_I2C_FAILURE,
+* CY_HPI_MASTER_SLAVE_QUARANTINED or CY_HPI_MASTER_TIMEOUT if the write did
+* not complete.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If all the writes are successful.
+* CY_HPI_MASTER_FAILURE - If a write failed. See slaveStatus.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_GroupWrite(cy_hpi_master_context_t *context,
+                                                const uint8_t *slaveIdxList,
+                                                uint8_t listLen,
+                                                uint16_t regAddress,
+                                                void *writeBuff,
+                                                uint16_t writeLen,
+                                                cy_hpi_master_status_t *slaveStatus);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwUpdateStart
+****************************************************************************//**
+*
+* Starts writing the same firmware image to several slave devices. The
+* update of each slave device is a sequence of ENTER_FLASH_MODE, one
+* FLASH_READ_WRITE row write per image row, the stream flush if streaming
+* row writes are selected, and VALIDATE_FW. Each step is issued when the
+* device response to the previous step is received, so while one slave
+* device programs a flash row, the row data of the other slave devices is
+* transferred. The register writes are queued on the asynchronous
+* transaction queue of the bus of each slave device; the queue of a bus
+* needs two entries per slave device on that bus.
+*
+* The device responses of the slave devices being updated are handled by
+* \ref Cy_HPI_Master_Task and are not passed to the event handler. The
+* slave devices therefore need their interrupt or poll timer serviced as
+* usual. The application follows the progress of each slave device through
+* the state and rowsDone members of its \ref cy_hpi_master_fwu_slave_t,
+* and calls \ref Cy_HPI_Master_FwUpdateIdle to detect the end of the update.
+* The slave devices stay in flashing mode; the application resets them
+* once the update is finished.
+*
+* If the timeout member is not zero, the update of a slave device which does
+* not respond to a step within the timeout ends in
+* CY_HPI_MASTER_FWU_STATE_FAILED with the status CY_HPI_MASTER_TIMEOUT. The
+* timeout is counted by \ref Cy_HPI_Master_PollTimerHandler and applied by
+* \ref Cy_HPI_Master_Task.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \param fwUpdate
+* Update description, with the slaveIdx member of each slave device entry
+* set. Must stay valid until \ref Cy_HPI_Master_FwUpdateIdle returns true.
+*
+* \return
+* CY_HPI_MASTER_SUCCESS - If the update is started. Slave devices whose
+* first write failed are in CY_HPI_MASTER_FWU_STATE_FAILED.
+* CY_HPI_MASTER_FAILURE - If an update is already in progress.
+* CY_HPI_MASTER_INVALID_ARGS - Invalid arguments passed.
+*
+*******************************************************************************/
+cy_hpi_master_status_t Cy_HPI_Master_FwUpdateStart(cy_hpi_master_context_t *context,
+                                                   cy_hpi_master_fw_update_t *fwUpdate);
+
+/*******************************************************************************
+* Function name: Cy_HPI_Master_FwUpdateIdle
+****************************************************************************//**
+*
+* Checks whether the firmware update started with
+* \ref Cy_HPI_Master_FwUpdateStart is finished, that is, each slave device
+* is in CY_HPI_MASTER_FWU_STATE_DONE or CY_HPI_MASTER_FWU_STATE_FAILED. The
+* update is then released, and a new one can be started.
+*
+* \param context
+* HPI master library context pointer.
+*
+* \return
+* true - If no firmware update is in progress.
+* false - Otherwise.
+*
+*******************************************************************************/
+bool Cy_HPI_Master_FwUpdateIdle(cy_hpi_master_context_t *context);
+
 /** \} group_hpim_functions */
 
 #endif  /* CY_HPI_MASTER_H */
@@ -58,6 +58,35 @@
 /** Command code to write a flash row. */
 #define CY_HPI_MASTER_FLASH_ROW_WRITE_CMD             (0x01U)
 
+/** Command code to write a flash row in streaming mode. The slave responds
+ *  once the row data is copied, while the row is programmed in background. */
+#define CY_HPI_MASTER_FLASH_ROW_STREAM_WRITE_CMD      (0x02U)
+
+/** Command code to wait for all streamed flash rows to be programmed. */
+#define CY_HPI_MASTER_FLASH_STREAM_FLUSH_CMD          (0x03U)
+
+/** Command code to write a flash row from run-length encoded data in
+ *  streaming mode. */
+#define CY_HPI_MASTER_FLASH_ROW_RLE_WRITE_CMD         (0x04U)
+
+/** Signature for the extended flash commands. */
+#define CY_HPI_MASTER_FLASH_EXT_CMD_SIG               ('X')
+
+/** Extended flash command code to read the CRC-32 of a range of flash rows. */
+#define CY_HPI_MASTER_FLASH_EXT_ROW_CRC_CMD           (0x01U)
+
+/** Extended flash command code to program a flash row with a fill byte. */
+#define CY_HPI_MASTER_FLASH_EXT_FILL_ROW_CMD          (0x02U)
+
+/** Extended flash command code to start tracking the CRC of an image. */
+#define CY_HPI_MASTER_FLASH_EXT_IMAGE_BEGIN_CMD       (0x03U)
+
+/** Extended flash command code to check the CRC of the written image. */
+#define CY_HPI_MASTER_FLASH_EXT_IMAGE_END_CMD         (0x04U)
+
+/** Extended flash command code to read the image transfer progress. */
+#define CY_HPI_MASTER_FLASH_EXT_PROGRESS_CMD          (0x05U)
+
 /** Size of the firmware binary version. */
 #define CY_HPI_MASTER_FW_VERSION_SIZE                 (8U)
 
@@ -73,6 +102,199 @@
 /** HPI slave invalid index number. */
 #define CY_HPI_MASTER_UNKNOWN_SLAVE_IDX               (0xFFU)
 
+/** Number of 32-bit words in the slave interrupt pending bitmap for the given
+ *  number of slave devices. */
+#define CY_HPI_MASTER_INTR_MASK_WORDS(slaveCnt)       (((uint32_t)(slaveCnt) + 31U) / 32U)
+
+/** Scheduling flag: service pending slave devices in round-robin order,
+ *  starting after the slave serviced last, and dispatch queued events even
+ *  while slave interrupts are pending. */
+#define CY_HPI_MASTER_SCHED_ROUND_ROBIN               (0x01U)
+
+/** Scheduling flag: deliver overcurrent, overvoltage, and overtemperature
+ *  events without queuing them, and service the slave devices which reported
+ *  them before any other slave device. */
+#define CY_HPI_MASTER_SCHED_FAULT_PRIORITY            (0x02U)
+
+/** Event queue overflow policy: drop the new event and report
+ *  CY_HPI_MASTER_QUEUE_OVERFLOW through the error handler. */
+#define CY_HPI_MASTER_QUEUE_DROP_NEWEST               (0x00U)
+
+/** Event queue overflow policy: drop the oldest queued events to make room
+ *  for the new event. */
+#define CY_HPI_MASTER_QUEUE_DROP_OLDEST               (0x01U)
+
+/** Event queue overflow policy: replace the data of the newest queued event
+ *  with the same slave device, port, event code and data length by the new
+ *  event data. Other events are dropped as with
+ *  CY_HPI_MASTER_QUEUE_DROP_NEWEST. */
+#define CY_HPI_MASTER_QUEUE_COALESCE                  (0x02U)
+
+/** Number of bytes at the start of each event pool block which hold the
+ *  response header. The event data follows the header. */
+#define CY_HPI_MASTER_EVT_POOL_HDR_SIZE               (4U)
+
+/** Maximum number of blocks in the event pool. */
+#define CY_HPI_MASTER_EVT_POOL_MAX_BLOCKS             (32U)
+
+/** Event pool block size for events with a few data bytes, such as the
+ *  status change events. */
+#define CY_HPI_MASTER_EVT_POOL_BLOCK_SMALL            (16U)
+
+/** Event pool block size for a source or sink PDO list (7 PDOs). */
+#define CY_HPI_MASTER_EVT_POOL_BLOCK_PDO              (32U)
+
+/** Event pool block size for a VDM: the SOP type word, the VDM header and
+ *  up to 6 VDOs. */
+#define CY_HPI_MASTER_EVT_POOL_BLOCK_VDM              (36U)
+
+/** Event pool block size for an extended message of up to 260 bytes. */
+#define CY_HPI_MASTER_EVT_POOL_BLOCK_EXT              (264U)
+
+/** Interrupt GPIO port number of a slave device without an interrupt line.
+ *  Cy_HPI_Master_Task polls the Interrupt Status register of such slaves. */
+#define CY_HPI_MASTER_INTR_GPIO_NONE                  (0xFFU)
+
+/** Default shortest poll interval, used if pollIntervalMin is 0. */
+#define CY_HPI_MASTER_POLL_INTERVAL_MIN_DEFAULT       (5U)
+
+/** Default longest poll interval, used if pollIntervalMax is 0. */
+#define CY_HPI_MASTER_POLL_INTERVAL_MAX_DEFAULT       (500U)
+
+/** Slave device health state: the slave device is serviced normally. */
+#define CY_HPI_MASTER_HEALTH_OK                       (0x00U)
+
+/** Slave device health state: failThreshold register accesses to the slave
+ *  device failed without a successful service in between. Its interrupts are ignored and register accesses
+ *  return CY_HPI_MASTER_SLAVE_QUARANTINED without an I2C transfer until the
+ *  backoff time expires. */
+#define CY_HPI_MASTER_HEALTH_QUARANTINED              (0x01U)
+
+/** Slave device health state: the backoff time of a quarantined slave
+ *  device expired, and its next service is a probe. A successful probe
+ *  returns the slave device to CY_HPI_MASTER_HEALTH_OK, a failed probe
+ *  quarantines it again with twice the backoff time. */
+#define CY_HPI_MASTER_HEALTH_PROBING                  (0x02U)
+
+/** Default number of failed register accesses without a successful service
+ *  in between after which a slave device is quarantined, used if
+ *  failThreshold is 0. */
+#define CY_HPI_MASTER_FAIL_THRESHOLD_DEFAULT          (5U)
+
+/** Default first backoff time of a quarantined slave device, used if
+ *  backoffMin is 0. */
+#define CY_HPI_MASTER_BACKOFF_MIN_DEFAULT             (100U)
+
+/** Default longest backoff time, used if backoffMax is 0. */
+#define CY_HPI_MASTER_BACKOFF_MAX_DEFAULT             (10000U)
+
+/** HPI slave I2C address selected by a low level on the address pin. */
+#define CY_HPI_MASTER_ADDR_I2C_CFG_LOW                (0x40U)
+
+/** HPI slave I2C address selected by a high level on the address pin. */
+#define CY_HPI_MASTER_ADDR_I2C_CFG_HIGH               (0x42U)
+
+/** HPI slave I2C address selected by a floating address pin. */
+#define CY_HPI_MASTER_ADDR_I2C_CFG_FLOAT              (0x08U)
+
+/** Number of well-known HPI slave I2C addresses probed by
+ *  Cy_HPI_Master_DiscoverSlaves when no address list is given. */
+#define CY_HPI_MASTER_DISCOVER_ADDR_COUNT             (3U)
+
+/** Device Mode register: current firmware mode (0: bootloader, 1: FW1,
+ *  2: FW2). */
+#define CY_HPI_MASTER_DEV_MODE_FW_MASK                (0x03U)
+
+/** Device Mode register: number of PD ports minus one. */
+#define CY_HPI_MASTER_DEV_MODE_PORT_MASK              (0x0CU)
+
+/** Device Mode register: position of the PD port count field. */
+#define CY_HPI_MASTER_DEV_MODE_PORT_POS               (2U)
+
+/** Trace register class: device registers. */
+#define CY_HPI_MASTER_TRACE_CLASS_DEV                 (0U)
+
+/** Trace register class: flash memory window. */
+#define CY_HPI_MASTER_TRACE_CLASS_FLASH               (1U)
+
+/** Trace register class: port registers. */
+#define CY_HPI_MASTER_TRACE_CLASS_PORT                (2U)
+
+/** Trace register class: PD response and PD message registers. */
+#define CY_HPI_MASTER_TRACE_CLASS_PD_RESP             (3U)
+
+/** Trace class of event delivery: from the slave interrupt to the event
+ *  handler call. */
+#define CY_HPI_MASTER_TRACE_CLASS_EVENT               (4U)
+
+/** Number of trace classes. */
+#define CY_HPI_MASTER_TRACE_CLASS_COUNT               (5U)
+
+/** Number of buckets of a trace latency histogram. */
+#define CY_HPI_MASTER_TRACE_BUCKETS                   (16U)
+
+/** Number of trace statistics entries for the given number of slave
+ *  devices. */
+#define CY_HPI_MASTER_TRACE_STATS_ENTRIES(slaveCnt)   ((uint32_t)(slaveCnt) * CY_HPI_MASTER_TRACE_CLASS_COUNT)
+
+/** Trace record flag: register write. */
+#define CY_HPI_MASTER_TRACE_FLAG_WRITE                (0x01U)
+
+/** Trace record flag: the transaction failed. */
+#define CY_HPI_MASTER_TRACE_FLAG_ERROR                (0x02U)
+
+/** Trace record flag: asynchronous transaction. The latency includes the
+ *  time spent in the transaction queue. */
+#define CY_HPI_MASTER_TRACE_FLAG_ASYNC                (0x04U)
+
+/** Trace record flag: event delivery. regAddr holds the port number in bits
+ *  15:8 and the event code in bits 7:0. */
+#define CY_HPI_MASTER_TRACE_FLAG_EVENT                (0x08U)
+
+/** I2C capability flag: i2c_master_read and i2c_master_read_async write the
+ *  register address and read the data in one transfer, with a repeated
+ *  start instead of a STOP and a START. If the flag is clear and
+ *  i2c_master_write_read is provided, register reads use it, and queued
+ *  transactions are executed with the blocking callbacks. */
+#define CY_HPI_MASTER_I2C_CAP_REPEATED_START          (0x01U)
+
+/** Firmware update state: waiting for the ENTER_FLASH_MODE response. */
+#define CY_HPI_MASTER_FWU_STATE_ENTER                 (0U)
+
+/** Firmware update state: waiting for the response to a row write. */
+#define CY_HPI_MASTER_FWU_STATE_ROW                   (1U)
+
+/** Firmware update state: waiting for the response to the stream flush. */
+#define CY_HPI_MASTER_FWU_STATE_FLUSH                 (2U)
+
+/** Firmware update state: waiting for the VALIDATE_FW response. */
+#define CY_HPI_MASTER_FWU_STATE_VALIDATE              (3U)
+
+/** Firmware update state: the image is written and validated. */
+#define CY_HPI_MASTER_FWU_STATE_DONE                  (4U)
+
+/** Firmware update state: the update failed. See the response and status
+ *  members of the slave device update state. */
+#define CY_HPI_MASTER_FWU_STATE_FAILED                (5U)
+
+/** Port number selecting all ports of a slave device. */
+#define CY_HPI_MASTER_PORT_ALL                        (0xFFU)
+
+/** Number of ports per slave device in the port register cache. */
+#define CY_HPI_MASTER_CACHE_PORT_COUNT                (2U)
+
+/** First port register held in the port register cache (PD_STATUS). */
+#define CY_HPI_MASTER_CACHE_REG_START                 (0x08U)
+
+/** Size of the port register cache of one port: the registers from 0x08 to
+ *  0x17. PD_STATUS, TYPE_C_STATUS, CURRENT_PDO and CURRENT_RDO are cached.
+ *  BUS_VOLTAGE is always read from the device. */
+#define CY_HPI_MASTER_CACHE_REG_SIZE                  (16U)
+
+/** Number of port register cache entries required for the given number of
+ *  slave devices. */
+#define CY_HPI_MASTER_CACHE_ENTRIES(slaveCnt)         ((uint32_t)(slaveCnt) * CY_HPI_MASTER_CACHE_PORT_COUNT)
+
 /** \} group_hpim_macros */
 
 /**
@@ -93,6 +315,12 @@ typedef enum
     CY_HPI_MASTER_INVALID_ARGS             = 2U,            /**< Invalid argument passed. */
     CY_HPI_MASTER_QUEUE_OVERFLOW           = 3U,            /**< HPI master event queue overflow error. */
     CY_HPI_MASTER_I2C_FAILURE              = 4U,            /**< HPI master read/write to slave device failure. */
+    CY_HPI_MASTER_SLAVE_QUARANTINED        = 5U,            /**< Slave device quarantined after repeated I2C failures. */
+    CY_HPI_MASTER_SLAVE_RECOVERED          = 6U,            /**< Quarantined slave device responded to a probe. Reported through the error handler only. */
+    CY_HPI_MASTER_BUS_RECOVERED            = 7U,            /**< Stuck I2C bus released by the bus recovery sequence. Reported through the error handler only. */
+    CY_HPI_MASTER_BUS_STUCK                = 8U,            /**< I2C bus recovery sequence failed to release SDA. Reported through the error handler only. */
+    CY_HPI_MASTER_TIMEOUT                  = 9U,            /**< Slave device did not respond in time, or the I2C bus stayed busy with a queued transfer. */
+    CY_HPI_MASTER_SLAVE_PROBING            = 10U,           /**< Backoff time of a quarantined slave device expired and it is probed. Reported through the error handler only. */
 } cy_hpi_master_status_t;
 
 /**
@@ -236,6 +464,7 @@ typedef enum
     CY_HPI_MASTER_DEV_REG_CFGTAB_VERSION          = 0x3A,   /**< Config Table Version register. */
     CY_HPI_MASTER_DEV_REG_SYS_PWR_STATE           = 0x3B,   /**< System Power State register. */
     CY_HPI_MASTER_DEV_REG_HPI_VERSION             = 0x3C,   /**< HPI Version register: LSB */
+    CY_HPI_MASTER_DEV_REG_FLASH_EXT_CMD           = 0x68,   /**< Extended flash command register. */
     CY_HPI_MASTER_DEV_REG_RESPONSE                = 0x7E,   /**< Response Type register. */
 } cy_hpi_master_dev_reg_t;
 
@@ -255,10 +484,12 @@ typedef enum
     CY_HPI_MASTER_PORT_REG_PD_CTRL                = 0x06,   /**< PD Control register. */
     CY_HPI_MASTER_PORT_REG_PD_STATUS              = 0x08,   /**< PD Status register: LS byte. */
     CY_HPI_MASTER_PORT_REG_TYPE_C_STATUS          = 0x0C,   /**< Type-C Status register. */
+    CY_HPI_MASTER_PORT_REG_BUS_VOLTAGE            = 0x0D,   /**< VBus voltage in 100 mV units. */
     CY_HPI_MASTER_PORT_REG_CURRENT_PDO            = 0x10,   /**< Current PDO register. */
     CY_HPI_MASTER_PORT_REG_CURRENT_RDO            = 0x14,   /**< Current RDO register. */
     CY_HPI_MASTER_PORT_REG_EVENT_MASK             = 0x24,   /**< Event Mask register: LS byte. */
     CY_HPI_MASTER_PORT_REG_SWAP_RESPONSE          = 0x28,   /**< PD Control register. */
+    CY_HPI_MASTER_PORT_REG_BUS_CURRENT            = 0x58,   /**< VBus current in 50 mA units. */
 } cy_hpi_master_port_reg_t;
 
 /** \} group_hpim_enums */
@@ -271,6 +502,31 @@ typedef enum
 /** Forward declaration of structures. */
 struct cy_hpi_master_context;
 
+/**
+ * @brief Identification of a slave device found by Cy_HPI_Master_DiscoverSlaves.
+ */
+typedef struct cy_hpi_master_dev_info
+{
+    /** Slave I2C address (7 bits). */
+    uint8_t slaveAddr;
+
+    /** Slave device index assigned at registration. */
+    uint8_t slaveIdx;
+
+    /** Content of the Device Mode register. */
+    uint8_t deviceMode;
+
+    /** Number of PD ports, decoded from the Device Mode register. */
+    uint8_t portCount;
+
+    /** Silicon ID. */
+    uint16_t siliconId;
+
+    /** Content of the All Version registers: bootloader, FW1 and FW2
+        versions. */
+    uint8_t allVersion[CY_HPI_MASTER_DEV_REG_ALL_VERSION_BYTES];
+}cy_hpi_master_dev_info_t;
+
 /**
  * @brief Structure to hold the HPI slave device information.
  */
@@ -291,11 +547,85 @@ typedef struct cy_hpi_master_slave_dev
     /** Variable to hold the status of the Interrupt register. */
     uint8_t intrReg;
     
-    /** Failure count. */
+    /** Number of failed register accesses since the last successful service. */
     uint8_t failCount;
+
+    /** Current poll interval of a slave device without an interrupt GPIO. */
+    uint16_t pollInterval;
+
+    /** Time left until the next poll. 0 while a poll is pending. */
+    volatile uint16_t pollCountdown;
+
+    /** Index of the I2C bus the slave device is connected to. */
+    uint8_t busIdx;
+
+    /** Health state (CY_HPI_MASTER_HEALTH_*). */
+    volatile uint8_t health;
+
+    /** Current backoff time of a quarantined slave device. */
+    uint16_t backoff;
+
+    /** Time left until a quarantined slave device is probed. */
+    volatile uint16_t backoffCountdown;
+
+    /** Time stamp of the interrupt being serviced, used by the trace. */
+    volatile uint32_t intrTimestamp;
 }cy_hpi_master_slave_dev_t;
 
 
+/**
+ * @brief Port status read by Cy_HPI_Master_PortStatusRead.
+ */
+typedef struct cy_hpi_master_port_status
+{
+    /** PD Status register. */
+    uint32_t pdStatus;
+
+    /** Current PDO register. */
+    uint32_t currentPdo;
+
+    /** Current RDO register. */
+    uint32_t currentRdo;
+
+    /** VBus voltage in mV. */
+    uint16_t busVoltage;
+
+    /** VBus current in mA. 0 if not read. */
+    uint16_t busCurrent;
+
+    /** Type-C Status register. */
+    uint8_t typeCStatus;
+}cy_hpi_master_port_status_t;
+
+/**
+ * @brief Segment of a scatter-gather PD response register access.
+ */
+typedef struct cy_hpi_master_pd_seg
+{
+    /** Offset from the response register base address. */
+    uint16_t offset;
+
+    /** Number of bytes. */
+    uint16_t length;
+
+    /** Data buffer pointer. */
+    uint8_t *buffer;
+}cy_hpi_master_pd_seg_t;
+
+/**
+ * @brief Cached PD_STATUS, TYPE_C_STATUS, CURRENT_PDO and CURRENT_RDO
+ * registers of one slave device port.
+ */
+typedef struct cy_hpi_master_port_cache
+{
+    /** Register values, starting at CY_HPI_MASTER_CACHE_REG_START. */
+    uint8_t regs[CY_HPI_MASTER_CACHE_REG_SIZE];
+
+    /** Valid flag of each 4-byte register (bit 0: PD_STATUS, bit 1:
+        TYPE_C_STATUS, bit 2: CURRENT_PDO, bit 3: CURRENT_RDO). */
+    uint8_t validMask;
+}cy_hpi_master_port_cache_t;
+
 /**
 * @brief Data structure to store the current event/response information.
 */
@@ -317,6 +647,107 @@ typedef struct cy_hpi_master_event
     uint16_t dataLen;
 }cy_hpi_master_event_t;
 
+/**
+* @brief Completion callback of an asynchronous register transaction. It is
+* called from \ref Cy_HPI_Master_Task.
+*/
+typedef void (*cy_hpi_master_xfer_cbk_t)(
+        struct cy_hpi_master_context *context,              /**< HPI master context structure pointer. */
+        cy_hpi_master_status_t status,                      /**< Transaction status. */
+        void *tag                                           /**< User tag passed when the transaction was queued. */
+        );
+
+/**
+* @brief Asynchronous register transaction. The application provides an array
+* of these entries to be used as the transaction queue.
+*/
+typedef struct cy_hpi_master_xfer
+{
+    /** Completion callback. Can be NULL. */
+    cy_hpi_master_xfer_cbk_t cbk;
+
+    /** User tag passed to the completion callback. */
+    void *tag;
+
+    /** Data buffer. Must stay valid until the transaction completes. */
+    uint8_t *buffer;
+
+    /** Number of bytes to transfer. */
+    uint16_t length;
+
+    /** HPI register address (little endian). */
+    uint8_t regAddr[2];
+
+    /** Slave I2C address (7 bits). */
+    uint8_t slaveAddr;
+
+    /** Slave device index, or CY_HPI_MASTER_UNKNOWN_SLAVE_IDX. Set by the
+        library. */
+    uint8_t slaveIdx;
+
+    /** true for a register write, false for a register read. */
+    bool isWrite;
+
+    /** Transaction status. */
+    cy_hpi_master_status_t status;
+
+    /** Time stamp of the transaction request, used by the trace. */
+    uint32_t timestamp;
+}cy_hpi_master_xfer_t;
+
+/**
+* @brief I2C bus of the HPI master. Each bus has its own asynchronous
+* transaction queue, so transactions on different buses run concurrently.
+*/
+typedef struct cy_hpi_master_bus
+{
+    /** I2C SCB base address. */
+    CySCB_Type *ptrScbBase;
+
+    /** I2C driver context. */
+    cy_stc_scb_i2c_context_t *ptrI2cContext;
+
+    /** Pointer to the asynchronous transaction queue. Can be NULL if the
+        asynchronous transaction API is not used on this bus. */
+    cy_hpi_master_xfer_t *ptrXferQueue;
+
+    /** Number of entries in the asynchronous transaction queue. */
+    uint8_t xferQueueSize;
+
+    /** Number of queued transactions, including completed transactions
+        whose callback has not been called yet. */
+    volatile uint8_t xferCount;
+
+    /** Index of the oldest transaction whose callback has not been called. */
+    uint8_t xferHead;
+
+    /** Number of queued transactions which are completed. The transaction
+        on the bus, or the next one to start, is at xferHead + xferDone. */
+    volatile uint8_t xferDone;
+
+    /** Index of the next free transaction queue entry. */
+    uint8_t xferTail;
+
+    /** Set while an asynchronous transfer is on the bus. */
+    volatile bool xferBusy;
+
+    /** Set while a blocking transfer owns the bus. */
+    volatile bool xferHold;
+
+    /** GPIO port of the SCL pin, used by the bus recovery sequence. Can be
+        NULL to disable bus recovery. */
+    GPIO_PRT_Type *sclPort;
+
+    /** GPIO port of the SDA pin, used by the bus recovery sequence. */
+    GPIO_PRT_Type *sdaPort;
+
+    /** SCL pin number. */
+    uint8_t sclPin;
+
+    /** SDA pin number. */
+    uint8_t sdaPin;
+}cy_hpi_master_bus_t;
+
 /**
 * @brief Defines the solution-specific application callback.
 */
@@ -347,10 +778,102 @@ typedef struct cy_hpi_master_app_cbk
     bool (*error_handler)(struct cy_hpi_master_context *context,    /**< HPI master context structure pointer. */
                           cy_hpi_master_event_t *event              /**< Pointer to the event/response data. */
                           );                                        /**< Function for handling error conditions. */                          
+
+    bool (*i2c_master_read_async)(CySCB_Type *scbBase,              /**< I2C module base address. */
+                            uint8_t slaveAddr,                      /**< I2C slave address. */
+                            uint8_t *buffer,                        /**< Read data buffer pointer. */
+                            uint32_t count,                         /**< Read data length (bytes). */
+                            uint8_t *reg_addr,                      /**< Read data register address. */
+                            uint8_t reg_size,                       /**< Read data register length (bytes). */
+                            cy_stc_scb_i2c_context_t *i2cContext    /**< I2C driver context pointer. */
+                            );                                      /**< Optional function that starts a non-blocking register read
+                                                                         and returns. The application calls
+                                                                         Cy_HPI_Master_XferComplete when the transfer ends. Not
+                                                                         used if i2cCaps does not have
+                                                                         CY_HPI_MASTER_I2C_CAP_REPEATED_START and
+                                                                         i2c_master_write_read is provided. */
+
+    bool (*i2c_master_write_async)(CySCB_Type *scbBase,             /**< I2C module base address. */
+                            uint8_t slaveAddr,                      /**< I2C slave address. */
+                            uint8_t *buffer,                        /**< Write data buffer pointer. */
+                            uint32_t count,                         /**< Write data length (bytes). */
+                            uint8_t *reg_addr,                      /**< Write data register address. */
+                            uint8_t reg_size,                       /**< Write data register length (bytes). */
+                            cy_stc_scb_i2c_context_t *i2cContext    /**< I2C driver context pointer. */
+                            );                                      /**< Optional function that starts a non-blocking register write
+                                                                         and returns. The application calls
+                                                                         Cy_HPI_Master_XferComplete when the transfer ends. */
+
+    uint32_t (*get_timestamp)(void);                                /**< Optional function returning a free-running time stamp,
+                                                                         for example in microseconds. Required if ptrTrace is set. */
+
+    bool (*i2c_master_write_read)(CySCB_Type *scbBase,              /**< I2C module base address. */
+                            uint8_t slaveAddr,                      /**< I2C slave address. */
+                            uint8_t *wrBuffer,                      /**< Write data buffer pointer. */
+                            uint32_t wrCount,                       /**< Write data length (bytes). */
+                            uint8_t *rdBuffer,                      /**< Read data buffer pointer. */
+                            uint32_t rdCount,                       /**< Read data length (bytes). */
+                            cy_stc_scb_i2c_context_t *i2cContext    /**< I2C driver context pointer. */
+                            );                                      /**< Optional function that writes and then reads in one
+                                                                         transfer, with a repeated start between the write and
+                                                                         the read. If provided, it is used for the blocking
+                                                                         register reads, unless i2c_master_read is provided
+                                                                         and i2cCaps has CY_HPI_MASTER_I2C_CAP_REPEATED_START. */
+
+    uint8_t i2cCaps;                                                /**< I2C capability flags (CY_HPI_MASTER_I2C_CAP_*) of the
+                                                                         read callbacks. */
 }cy_hpi_master_app_cbk_t;
 
 /**
-* @brief HPI master queue data structure.
+* @brief HPI master event queue statistics.
+*/
+typedef struct cy_hpi_master_queue_stats
+{
+    /** Number of events added to the queue. */
+    uint32_t enqueued;
+
+    /** Number of events lost because of queue overflow. */
+    uint32_t dropped;
+
+    /** Number of events merged into a queued event. */
+    uint32_t coalesced;
+
+    /** Highest number of queue buffer bytes in use. */
+    uint16_t highWatermark;
+}cy_hpi_master_queue_stats_t;
+
+/**
+* @brief Event data pool. Port event data is read directly into a block of
+* the pool, and the block is passed to the application, which releases it
+* with Cy_HPI_Master_EventRelease. Several pools with different block sizes
+* can be used, one per event data size class.
+*/
+typedef struct cy_hpi_master_evt_pool
+{
+    /** Start address of the pool memory of blockCount * blockSize bytes. */
+    uint8_t *startAddress;
+
+    /** Size of a block, including CY_HPI_MASTER_EVT_POOL_HDR_SIZE bytes for
+        the response header. */
+    uint16_t blockSize;
+
+    /** Number of blocks (up to CY_HPI_MASTER_EVT_POOL_MAX_BLOCKS). */
+    uint8_t blockCount;
+
+    /** Bitmap of the free blocks. */
+    volatile uint32_t freeMask;
+
+    /** Number of events whose data was copied through ptrRespBuff because
+        no block of the pool or of a pool with larger blocks was free. */
+    uint32_t allocFailCount;
+}cy_hpi_master_evt_pool_t;
+
+/**
+* @brief HPI master queue data structure. Events are stored as variable-length
+* records in a ring buffer. The queue is written by the slave interrupt
+* servicing and read by Cy_HPI_Master_Task without disabling interrupts;
+* only the overflow policies other than CY_HPI_MASTER_QUEUE_DROP_NEWEST
+* use a critical section.
 */
 typedef struct cy_hpi_master_event_queue
 {
@@ -360,20 +883,177 @@ typedef struct cy_hpi_master_event_queue
     /** Size of the queue buffer. */
     uint16_t bufferSize;
 
-    /** Message start index. */
-    uint16_t headIdx;
+    /** Index of the oldest event record. Written by the reader. */
+    volatile uint16_t headIdx;
+
+    /** Index of the next free byte. Written by the writer. */
+    volatile uint16_t tailIdx;
+
+    /** Overflow policy (CY_HPI_MASTER_QUEUE_DROP_NEWEST,
+        CY_HPI_MASTER_QUEUE_DROP_OLDEST or CY_HPI_MASTER_QUEUE_COALESCE). Set
+        before calling Cy_HPI_Master_Init. */
+    uint8_t overflowPolicy;
 
-    /** Message end index. */
-    uint16_t tailIdx;
+    /** Set while the oldest event is being passed to the event handler. */
+    volatile bool dispatching;
+
+    /** Queue statistics. */
+    cy_hpi_master_queue_stats_t stats;
 }cy_hpi_master_event_queue_t;
 
+/**
+* @brief Transaction and event latency statistics of one slave device and
+* trace class.
+*/
+typedef struct cy_hpi_master_trace_stats
+{
+    /** Number of transactions or delivered events. */
+    uint32_t count;
+
+    /** Number of failed transactions. A failed interrupt service is retried
+        by the next Cy_HPI_Master_Task call, so this includes the retries. */
+    uint32_t errors;
+
+    /** Number of data bytes transferred, not counting register addresses. */
+    uint32_t bytes;
+
+    /** Longest latency. */
+    uint32_t maxLatency;
+
+    /** Latency histogram. Bucket 0 counts latencies of 0, bucket n counts
+        latencies from 2^(n-1) up to 2^n - 1, and the last bucket also counts
+        all longer latencies. */
+    uint32_t hist[CY_HPI_MASTER_TRACE_BUCKETS];
+}cy_hpi_master_trace_stats_t;
+
+/**
+* @brief Trace record of one transaction or event delivery.
+*/
+typedef struct cy_hpi_master_trace_rec
+{
+    /** Time stamp of the transaction start or of the slave interrupt. */
+    uint32_t timestamp;
+
+    /** Latency, in get_timestamp units. */
+    uint32_t latency;
+
+    /** HPI register address, or port and event code for events. */
+    uint16_t regAddr;
+
+    /** Number of data bytes. */
+    uint16_t length;
+
+    /** Slave I2C address (7 bits). */
+    uint8_t slaveAddr;
+
+    /** Record flags (CY_HPI_MASTER_TRACE_FLAG_*). */
+    uint8_t flags;
+}cy_hpi_master_trace_rec_t;
+
+/**
+* @brief Transaction trace of the HPI master.
+*/
+typedef struct cy_hpi_master_trace
+{
+    /** Pointer to the statistics, with
+        CY_HPI_MASTER_TRACE_STATS_ENTRIES(maxSlaveDevices) entries, indexed by
+        slave index * CY_HPI_MASTER_TRACE_CLASS_COUNT + class. */
+    cy_hpi_master_trace_stats_t *ptrStats;
+
+    /** Pointer to the trace record ring. Can be NULL to collect the
+        statistics only. */
+    cy_hpi_master_trace_rec_t *ptrRing;
+
+    /** Number of records in the ring. */
+    uint16_t ringSize;
+
+    /** Index of the next record to be written. */
+    uint16_t ringIdx;
+
+    /** Number of records written since initialization. The ring holds the
+        last ringSize of them. */
+    uint32_t ringCount;
+}cy_hpi_master_trace_t;
+
+/**
+* @brief Firmware update state of one slave device.
+*/
+typedef struct cy_hpi_master_fwu_slave
+{
+    /** Index of the slave device. Set by the application. */
+    uint8_t slaveIdx;
+
+    /** Update state (CY_HPI_MASTER_FWU_STATE_*). */
+    volatile uint8_t state;
+
+    /** Number of rows written. */
+    uint16_t rowsDone;
+
+    /** Last response code of the slave device. */
+    uint8_t response;
+
+    /** Reason of the failure of the update: CY_HPI_MASTER_FAILURE if the
+        slave device returned an error response (see response),
+        CY_HPI_MASTER_TIMEOUT if it did not respond in time, or the status of
+        the failed register write. CY_HPI_MASTER_SUCCESS while the update has
+        not failed. */
+    cy_hpi_master_status_t status;
+
+    /** Time left for the response to the current step. Counted down by
+        Cy_HPI_Master_PollTimerHandler. */
+    volatile uint16_t countdown;
+
+    /** Command buffer of the queued register writes. */
+    uint8_t cmd[4];
+}cy_hpi_master_fwu_slave_t;
+
+/**
+* @brief Firmware update of several slave devices with the same image.
+*/
+typedef struct cy_hpi_master_fw_update
+{
+    /** Pointer to the image: rowCount rows of rowSize bytes. */
+    const uint8_t *ptrImage;
+
+    /** Size of a flash row in bytes. */
+    uint16_t rowSize;
+
+    /** Flash row of the first image row. */
+    uint16_t startRow;
+
+    /** Number of image rows. */
+    uint16_t rowCount;
+
+    /** Firmware mode passed to VALIDATE_FW: 1 for FW1, 2 for FW2. */
+    uint8_t fwMode;
+
+    /** true to write the rows with CY_HPI_MASTER_FLASH_ROW_STREAM_WRITE_CMD.
+        Requires the flash update extensions on the slave devices. */
+    bool stream;
+
+    /** Pointer to the update state of the slave devices. */
+    cy_hpi_master_fwu_slave_t *ptrSlaves;
+
+    /** Number of slave devices to update. */
+    uint8_t slaveCount;
+
+    /** Number of slave devices whose update is in progress. */
+    volatile uint8_t activeCount;
+
+    /** Response timeout of each update step, in the unit of the elapsed
+        argument of Cy_HPI_Master_PollTimerHandler. Zero disables the
+        timeout. */
+    uint16_t timeout;
+}cy_hpi_master_fw_update_t;
+
 /**
 * @brief HPI master library data structure.
 */
 typedef struct cy_hpi_master_context
 {
-    /** Variable to store the slave interrupt status bit. */
-    uint8_t intrMask;
+    /** Summary of the slave interrupt pending bitmap. Bit n is set if any
+        slave interrupt bit is set in word n of the bitmap. */
+    uint32_t intrSummary;
 
     /** Number of slave devices registered. */
     uint8_t slaveCount;
@@ -403,6 +1083,111 @@ typedef struct cy_hpi_master_context
     /** Pointer to the PD response buffer. This buffer is used for handling the
         PD response message read/write operation. */
     uint8_t *ptrRespBuff;
+
+    /** Pointer to the slave interrupt pending bitmap, with one bit per slave
+        device. The array must hold CY_HPI_MASTER_INTR_MASK_WORDS(maxSlaveDevices)
+        words. Can be NULL if maxSlaveDevices is 32 or less, in which case
+        intrMaskWord is used. */
+    uint32_t *ptrIntrMask;
+
+    /** Slave interrupt pending bitmap used when ptrIntrMask is not provided. */
+    uint32_t intrMaskWord;
+
+    /** Scheduling flags (CY_HPI_MASTER_SCHED_*). Zero services all pending
+        slave devices in array order and dispatches queued events only when
+        no slave interrupt is pending. */
+    uint8_t schedFlags;
+
+    /** Maximum number of slave devices serviced in one Cy_HPI_Master_Task
+        call with CY_HPI_MASTER_SCHED_ROUND_ROBIN, not counting priority
+        slave devices. Zero services each pending slave device once. */
+    uint8_t slaveBudget;
+
+    /** Maximum number of queued events dispatched in one Cy_HPI_Master_Task
+        call with CY_HPI_MASTER_SCHED_ROUND_ROBIN. Zero dispatches one event.
+        Slave devices are not serviced while queued events are left. */
+    uint8_t evtBudget;
+
+    /** Index of the slave device to be serviced first in the next
+        round-robin pass. */
+    uint8_t rrNextIdx;
+
+    /** Pointer to the priority slave bitmap, with one bit per slave device.
+        A bit is set while the slave device reports overcurrent, overvoltage,
+        or overtemperature events. Same size and rules as ptrIntrMask. */
+    uint32_t *ptrPrioMask;
+
+    /** Priority slave bitmap used when ptrPrioMask is not provided. */
+    uint32_t prioMaskWord;
+
+    /** Pointer to the asynchronous transaction queue. Can be NULL if the
+        asynchronous transaction API is not used. */
+    cy_hpi_master_xfer_t *ptrXferQueue;
+
+    /** Number of entries in the asynchronous transaction queue. */
+    uint8_t xferQueueSize;
+
+    /** Pointer to the I2C buses. Can be NULL if all the slave devices are on
+        the bus set by ptrScbBase, ptrI2cContext, ptrXferQueue and
+        xferQueueSize. */
+    cy_hpi_master_bus_t *ptrBuses;
+
+    /** Number of I2C buses in ptrBuses. */
+    uint8_t busCount;
+
+    /** Bus used when ptrBuses is not provided. */
+    cy_hpi_master_bus_t defaultBus;
+
+    /** Number of response data bytes read in the same I2C transfer as the
+        port response header. Set to 0 to read the header and the data
+        separately. The header and the prefetched data must fit in
+        ptrRespBuff. */
+    uint16_t respPrefetchLen;
+
+    /** Pointer to the port register cache with
+        CY_HPI_MASTER_CACHE_ENTRIES(maxSlaveDevices) entries, indexed by
+        slave index * CY_HPI_MASTER_CACHE_PORT_COUNT + port. Can be NULL to
+        disable the cache. */
+    cy_hpi_master_port_cache_t *ptrPortCache;
+
+    /** Pointer to the event data pool, or to an array of evtPoolCount pools
+        in increasing order of block size. Can be NULL to pass the event data
+        through ptrRespBuff. */
+    cy_hpi_master_evt_pool_t *ptrEvtPool;
+
+    /** Number of pools in ptrEvtPool. 0 is handled as 1. */
+    uint8_t evtPoolCount;
+
+    /** Shortest poll interval of the slave devices without an interrupt
+        GPIO, in the time unit of Cy_HPI_Master_PollTimerHandler. The poll
+        interval is reset to this value when a poll finds an interrupt. */
+    uint16_t pollIntervalMin;
+
+    /** Longest poll interval. The poll interval doubles after each poll
+        which finds no interrupt, up to this value. */
+    uint16_t pollIntervalMax;
+
+    /** Number of failed register accesses without a successful service in
+        between after which a slave device is quarantined. 0 selects
+        CY_HPI_MASTER_FAIL_THRESHOLD_DEFAULT. */
+    uint8_t failThreshold;
+
+    /** First backoff time of a quarantined slave device, in the time unit of
+        Cy_HPI_Master_PollTimerHandler. */
+    uint16_t backoffMin;
+
+    /** Longest backoff time. The backoff time doubles after each failed
+        probe, up to this value. */
+    uint16_t backoffMax;
+
+    /** Number of slave devices which are not in CY_HPI_MASTER_HEALTH_OK. */
+    uint8_t unhealthyCount;
+
+    /** Pointer to the transaction trace. Can be NULL to disable tracing. */
+    cy_hpi_master_trace_t *ptrTrace;
+
+    /** Firmware update in progress. Set by Cy_HPI_Master_FwUpdateStart. */
+    cy_hpi_master_fw_update_t *ptrFwUpdate;
     
 }cy_hpi_master_context_t;
 